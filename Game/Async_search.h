@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../Models/Move.h"
+#include "Logic.h"
+#include "Spsc_queue.h"
+
+//      :     ,  
+//            .   ,
+//  Logic        
+class Async_search
+{
+  public:
+    ~Async_search()
+    {
+        abort();
+    }
+
+    //      color    logic
+    void start(Logic &logic, const bool color)
+    {
+        abort();
+        searcher = &logic;
+        stop_flag = false;
+        done = false;
+        result.clear();
+        searcher->set_stop_flag(&stop_flag);
+        searcher->set_progress([this](const search_info &info) { progress.push(info); });
+        worker = thread([this, color]() {
+            result = searcher->find_best_turns(color);
+            done = true;
+        });
+    }
+
+    //   
+    bool finished() const
+    {
+        return done;
+    }
+
+    //        , false -   
+    bool poll(search_info &info)
+    {
+        return progress.pop(info);
+    }
+
+    //    .    ,    
+    //     
+    vector<move_pos> take()
+    {
+        stop_flag = true;
+        join();
+        return result;
+    }
+
+    //       
+    void abort()
+    {
+        stop_flag = true;
+        join();
+        result.clear();
+    }
+
+  private:
+    //      Logic     
+    void join()
+    {
+        if (!worker.joinable())
+            return;
+        worker.join();
+        searcher->set_stop_flag(nullptr);
+        searcher->set_progress(nullptr);
+        search_info info;
+        while (progress.pop(info))
+            ; //      
+    }
+
+    Logic *searcher = nullptr; // ,    
+    thread worker; //  
+    atomic<bool> stop_flag{false};
+    atomic<bool> done{false};
+    vector<move_pos> result; //  ,      done
+    Spsc_queue<search_info, 64> progress; //    
+};
@@ -4,7 +4,9 @@
 #include <vector>
 
 #include "../Models/Move.h"
+#include "../Models/Move_history.h"
 #include "../Models/Project_path.h"
+#include "Texture_atlas.h"
 
 //       SDL    
 #ifdef APPLE
@@ -68,17 +70,11 @@ public:
             return 1; //     
         }
 
-        //      
+        //  :   ,  ,   , -  .
+        //      Sprite
         board = IMG_LoadTexture(ren, board_path.c_str());
-        w_piece = IMG_LoadTexture(ren, piece_white_path.c_str());
-        b_piece = IMG_LoadTexture(ren, piece_black_path.c_str());
-        w_queen = IMG_LoadTexture(ren, queen_white_path.c_str());
-        b_queen = IMG_LoadTexture(ren, queen_black_path.c_str());
-        back = IMG_LoadTexture(ren, back_path.c_str());
-        replay = IMG_LoadTexture(ren, replay_path.c_str());
-
-        //    
-        if (!board || !w_piece || !b_piece || !w_queen || !b_queen || !back || !replay)
+        if (!board || !atlas.build(ren, {piece_white_path, piece_black_path, queen_white_path, queen_black_path,
+                                         back_path, replay_path, white_path, black_path, draw_path}))
         {
             print_exception("IMG_LoadTexture can't load main textures from " + textures_path);
             return 1;
@@ -87,7 +83,7 @@ public:
         //   
         SDL_GetRendererOutputSize(ren, &W, &H);
         make_start_mtx(); //    
-        rerender(); //  
+        present(); //  
         return 0; //  
     }
 
@@ -95,9 +91,7 @@ public:
     void redraw()
     {
         game_results = -1; //   
-        history_mtx.clear(); //   
-        history_beat_series.clear(); //    
-        make_start_mtx(); //    
+        make_start_mtx(); //        
         clear_active(); //   
         clear_highlight(); //  
     }
@@ -106,44 +100,34 @@ public:
 
     //          
     void move_piece(move_pos turn, const int beat_series = 0)
-    {
-        if (turn.xb != -1) //    
-        {
-
-            mtx[turn.xb][turn.yb] = 0; //  ,    
-        }
-        move_piece(turn.x, turn.y, turn.x2, turn.y2, beat_series); //  
-    }
-
-
-
-    //       
-    void move_piece(const POS_T i, const POS_T j, const POS_T i2, const POS_T j2, const int beat_series = 0)
     {
         // ,    
-        if (mtx[i2][j2])
+        if (mtx[turn.x2][turn.y2])
         {
             throw runtime_error("final position is not empty, can't move"); // ,    
         }
         // ,     
-        if (!mtx[i][j])
+        if (!mtx[turn.x][turn.y])
         {
             throw runtime_error("begin position is empty, can't move"); // ,    
         }
-        //      
-        if ((mtx[i][j] == 1 && i2 == 0) || (mtx[i][j] == 2 && i2 == 7))
-            mtx[i][j] += 2; //    2  
+        //    :         
+        apply(history.push(turn, beat_series));
+    }
+
 
-        mtx[i2][j2] = mtx[i][j]; //  
-        drop_piece(i, j); //     
-        add_history(beat_series); //      
+
+    //       
+    void move_piece(const POS_T i, const POS_T j, const POS_T i2, const POS_T j2, const int beat_series = 0)
+    {
+        move_piece(move_pos(i, j, i2, j2), beat_series);
     }
 
     //      
     void drop_piece(const POS_T i, const POS_T j)
     {
         mtx[i][j] = 0;
-        rerender();
+        invalidate();
     }
 
     //       
@@ -154,7 +138,7 @@ public:
             throw runtime_error("can't turn into queen in this position");
         }
         mtx[i][j] += 2;
-        rerender();
+        invalidate();
     }
     //      
     vector<vector<POS_T>> get_board() const
@@ -170,7 +154,7 @@ public:
             POS_T x = pos.first, y = pos.second;
             is_highlighted_[x][y] = 1;
         }
-        rerender();
+        invalidate();
     }
 
     //       
@@ -180,7 +164,7 @@ public:
         {
             is_highlighted_[i].assign(8, 0);
         }
-        rerender();
+        invalidate();
     }
 
     //     
@@ -188,7 +172,7 @@ public:
     {
         active_x = x;
         active_y = y;
-        rerender();
+        invalidate();
     }
     
     //     
@@ -196,7 +180,7 @@ public:
     {
         active_x = -1;
         active_y = -1;
-        rerender();
+        invalidate();
     }
     //   ,    
 
@@ -205,33 +189,61 @@ public:
         return is_highlighted_[x][y];
     }
 
-    //     
+    //     ,    
     void rollback()
     {
-        auto beat_series = max(1, *(history_beat_series.rbegin()));
-        while (beat_series-- && history_mtx.size() > 1)
-        {
-            history_mtx.pop_back();
-            history_beat_series.pop_back();
-        }
-        mtx = *(history_mtx.rbegin());
+        if (!history.can_undo())
+            return;
+        int beat_series = max(1, int(history.back().series));
+        while (beat_series-- && history.can_undo())
+            revert(history.undo());
         clear_highlight();
         clear_active();
     }
+
+    //   
+    const Move_history& get_history() const
+    {
+        return history;
+    }
     //      
     void show_final(const int res)
     {
         game_results = res;
+        invalidate();
+    }
+
+    //   ,    .     :
+    //     ,         present
+    void invalidate()
+    {
+        is_dirty = true;
+    }
+
+    //    ,      .   
+    //  (Hand),         ,   
+    //  -        
+    void present()
+    {
+        if (!is_dirty || !ren)
+            return;
+        is_dirty = false;
         rerender();
     }
 
+    //          ,   -  
+    void set_title(const string& text)
+    {
+        SDL_SetWindowTitle(win, text.empty() ? "Checkers" : ("Checkers - " + text).c_str());
+    }
+
     // use if window size changed
     //         
 
     void reset_window_size()
     {
         SDL_GetRendererOutputSize(ren, &W, &H); //    
-        rerender(); //     
+        invalidate(); //     
     }
 
     //        
@@ -239,12 +251,7 @@ public:
     void quit()
     {
         SDL_DestroyTexture(board);
-        SDL_DestroyTexture(w_piece);
-        SDL_DestroyTexture(b_piece);
-        SDL_DestroyTexture(w_queen);
-        SDL_DestroyTexture(b_queen);
-        SDL_DestroyTexture(back);
-        SDL_DestroyTexture(replay);
+        atlas.destroy();
         SDL_DestroyRenderer(ren);
         SDL_DestroyWindow(win);
         SDL_Quit();
@@ -259,11 +266,26 @@ public:
 
 
 private:
-    //       
-    void add_history(const int beat_series = 0)
+    //        
+    void apply(const history_entry& e)
     {
-        history_mtx.push_back(mtx);
-        history_beat_series.push_back(beat_series);
+        const Rays& r = rays();
+        POS_T& piece = mtx[r.x[e.from]][r.y[e.from]];
+        if (e.beaten != history_entry::NO_BEATEN)
+            mtx[r.x[e.beaten]][r.y[e.beaten]] = 0; //   
+        mtx[r.x[e.to]][r.y[e.to]] = POS_T(piece + (e.promoted ? 2 : 0));
+        drop_piece(r.x[e.from], r.y[e.from]); //     
+    }
+
+    //        
+    void revert(const history_entry& e)
+    {
+        const Rays& r = rays();
+        POS_T& piece = mtx[r.x[e.to]][r.y[e.to]];
+        mtx[r.x[e.from]][r.y[e.from]] = POS_T(piece - (e.promoted ? 2 : 0));
+        if (e.beaten != history_entry::NO_BEATEN)
+            mtx[r.x[e.beaten]][r.y[e.beaten]] = POS_T(e.beaten_type); //   
+        drop_piece(r.x[e.to], r.y[e.to]);
     }
     // function to make start matrix
         //        
@@ -281,7 +303,7 @@ private:
                     mtx[i][j] = 1;
             }
         }
-        add_history();
+        history.reset(Position(mtx));
     }
 
     // function that re-draw all the textures
@@ -293,49 +315,25 @@ private:
         SDL_RenderClear(ren);
         SDL_RenderCopy(ren, board, NULL, NULL); //   
 
-        //    
-
-        for (POS_T i = 0; i < 8; ++i)
-        {
-            for (POS_T j = 0; j < 8; ++j)
-            {
-                if (!mtx[i][j])
-                    continue;
-                int wpos = W * (j + 1) / 10 + W / 120;
-                int hpos = H * (i + 1) / 10 + H / 120;
-                SDL_Rect rect{ wpos, hpos, W / 12, H / 12 };
-
-                SDL_Texture* piece_texture;
-                if (mtx[i][j] == 1)
-                    piece_texture = w_piece;
-                else if (mtx[i][j] == 2)
-                    piece_texture = b_piece;
-                else if (mtx[i][j] == 3)
-                    piece_texture = w_queen;
-                else
-                    piece_texture = b_queen;
-
-                SDL_RenderCopy(ren, piece_texture, NULL, &rect);
-            }
-        }
-
         // draw hilight
-        //   
+        //   :    
 
         SDL_SetRenderDrawColor(ren, 0, 255, 0, 0);
         const double scale = 2.5;
         SDL_RenderSetScale(ren, scale, scale);
+        cell_rects.clear();
         for (POS_T i = 0; i < 8; ++i)
         {
             for (POS_T j = 0; j < 8; ++j)
             {
                 if (!is_highlighted_[i][j])
                     continue;
-                SDL_Rect cell{ int(W * (j + 1) / 10 / scale), int(H * (i + 1) / 10 / scale), int(W / 10 / scale),
-                              int(H / 10 / scale) };
-                SDL_RenderDrawRect(ren, &cell);
+                cell_rects.push_back(SDL_Rect{ int(W * (j + 1) / 10 / scale), int(H * (i + 1) / 10 / scale),
+                                               int(W / 10 / scale), int(H / 10 / scale) });
             }
         }
+        if (!cell_rects.empty())
+            SDL_RenderDrawRects(ren, cell_rects.data(), int(cell_rects.size()));
 
         // draw active
         //   
@@ -349,41 +347,47 @@ private:
         }
         SDL_RenderSetScale(ren, 1, 1);
 
+        // ,          .  
+        //         ,    
+
+        for (POS_T i = 0; i < 8; ++i)
+        {
+            for (POS_T j = 0; j < 8; ++j)
+            {
+                if (!mtx[i][j])
+                    continue;
+                int wpos = W * (j + 1) / 10 + W / 120;
+                int hpos = H * (i + 1) / 10 + H / 120;
+                // 1 -  , 2 - , 3 -  , 4 -  ,    Sprite
+                atlas.add(WHITE_PIECE + mtx[i][j] - 1, SDL_Rect{ wpos, hpos, W / 12, H / 12 });
+            }
+        }
+
         // draw arrows
         //       
 
-        SDL_Rect rect_left{ W / 40, H / 40, W / 15, H / 15 };
-        SDL_RenderCopy(ren, back, NULL, &rect_left);
-        SDL_Rect replay_rect{ W * 109 / 120, H / 40, W / 15, H / 15 };
-        SDL_RenderCopy(ren, replay, NULL, &replay_rect);
+        atlas.add(BACK, SDL_Rect{ W / 40, H / 40, W / 15, H / 15 });
+        atlas.add(REPLAY, SDL_Rect{ W * 109 / 120, H / 40, W / 15, H / 15 });
 
         // draw result
         //    ,   
 
         if (game_results != -1)
         {
-            string result_path = draw_path;
+            int result_sprite = DRAW;
             if (game_results == 1)
-                result_path = white_path;
+                result_sprite = WHITE_WINS;
             else if (game_results == 2)
-                result_path = black_path;
-            SDL_Texture* result_texture = IMG_LoadTexture(ren, result_path.c_str());
-            if (result_texture == nullptr)
-            {
-                print_exception("IMG_LoadTexture can't load game result picture from " + result_path);
-                return;
-            }
-            SDL_Rect res_rect{ W / 5, H * 3 / 10, W * 3 / 5, H * 2 / 5 };
-            SDL_RenderCopy(ren, result_texture, NULL, &res_rect);
-            SDL_DestroyTexture(result_texture);
+                result_sprite = BLACK_WINS;
+            atlas.add(result_sprite, SDL_Rect{ W / 5, H * 3 / 10, W * 3 / 5, H * 2 / 5 });
         }
+        atlas.flush(ren);
 
         SDL_RenderPresent(ren);
         // next rows for mac os
-        //         macOS
-        SDL_Delay(10);
-        SDL_Event windowEvent;
-        SDL_PollEvent(&windowEvent);
+        //     macOS.     ,   ,
+        //    ,   Hand
+        SDL_PumpEvents();
     }
 
     //        -
@@ -396,9 +400,6 @@ private:
 public:
     int W = 0;
     int H = 0;
-    // history of boards
-    //       
-    vector<vector<vector<POS_T>>> history_mtx;
 
 private:
     SDL_Window* win = nullptr;
@@ -407,12 +408,22 @@ private:
     //      
 
     SDL_Texture* board = nullptr;
-    SDL_Texture* w_piece = nullptr;
-    SDL_Texture* b_piece = nullptr;
-    SDL_Texture* w_queen = nullptr;
-    SDL_Texture* b_queen = nullptr;
-    SDL_Texture* back = nullptr;
-    SDL_Texture* replay = nullptr;
+    //  ,    ,     start_draw
+    enum Sprite
+    {
+        WHITE_PIECE,
+        BLACK_PIECE,
+        WHITE_QUEEN,
+        BLACK_QUEEN,
+        BACK,
+        REPLAY,
+        WHITE_WINS,
+        BLACK_WINS,
+        DRAW
+    };
+    Texture_atlas atlas;
+    //    ,    
+    vector<SDL_Rect> cell_rects;
     // texture files names
     //    
     const string textures_path = project_path + "Textures/";
@@ -441,7 +452,10 @@ private:
     // 1 -  , 2 -  , 3 -  , 4 -  
 
     vector<vector<POS_T>> mtx = vector<vector<POS_T>>(8, vector<POS_T>(8, 0));
-    // series of beats for each move
-    //     
-    vector<int> history_beat_series;
+    // board changed since the last frame
+    //      
+    bool is_dirty = true;
+    // history of moves
+    //    :     
+    Move_history history;
 };
@@ -29,7 +29,7 @@ public:
     void reload()
     {
         std::ifstream fin(project_path + "settings.json"); //   
-        fin >> config; //      JSON
+        config = json::parse(fin, nullptr, true, true); //     JSON,    
         fin.close(); //  
     }
 
@@ -50,6 +50,35 @@ public:
         return config[setting_dir][setting_name]; //     JSON-
     }
 
+    /**
+     *  set()     ,      .
+     *    , ,       .
+     */
+    void set(const std::string& setting_dir, const std::string& setting_name, const json& value)
+    {
+        config[setting_dir][setting_name] = value;
+    }
+
+    /**
+     *  parse_value()   ,  ,    :
+     *    JSON,     JSON,  ,       .
+     */
+    static json parse_value(const std::string& text)
+    {
+        json parsed = json::parse(text, nullptr, false);
+        if (parsed.is_discarded())
+            parsed = text;
+        return parsed;
+    }
+
+    /**
+     *  set_parsed()      ,  parse_value().
+     */
+    void set_parsed(const std::string& setting_dir, const std::string& setting_name, const std::string& text)
+    {
+        set(setting_dir, setting_name, parse_value(text));
+    }
+
 private:
     json config; //  JSON,    
 };
\ No newline at end of file
@@ -0,0 +1,168 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <utility>
+
+#include "../Models/Position.h"
+#include "Leaf_batch.h"
+#include "Nnue.h"
+
+const int INF = 1e9;
+
+//   .  -     score    BotScoringType
+//  settings.json.     score  Eval_weights.
+//  score_batch    (Leaf_batch.h)     score   .
+//   Logic     ,     
+//      .
+//    ,         Evaluators_list.
+
+//  - 
+template <class... Items> struct type_list
+{
+};
+
+//  ,   Tools/tune.cpp
+struct Eval_weights
+{
+    double king_value = 5;    //     
+    double potential = 0.05;  //      
+};
+
+//      JSON-,      .
+//  false,      
+inline bool load_weights(const std::string &path, Eval_weights &weights)
+{
+    std::ifstream fin(path);
+    if (!fin)
+        return false;
+    const nlohmann::json data = nlohmann::json::parse(fin, nullptr, false, true);
+    if (data.is_discarded() || !data.is_object())
+        return false;
+    weights.king_value = data.value("KingValue", weights.king_value);
+    weights.potential = data.value("Potential", weights.potential);
+    return true;
+}
+
+//      JSON-
+inline bool save_weights(const std::string &path, const Eval_weights &weights)
+{
+    std::ofstream fout(path);
+    nlohmann::json data;
+    data["KingValue"] = weights.king_value;
+    data["Potential"] = weights.potential;
+    fout << data.dump(4) << "\n";
+    return bool(fout);
+}
+
+//     :      
+// w, b -      , king_coef -    
+inline double material_ratio(double w, double wq, double b, double bq, const bool first_bot_color,
+                             const double king_coef)
+{
+    if (!first_bot_color)
+    {
+        std::swap(b, w);
+        std::swap(bq, wq);
+    }
+    if (w + wq == 0)
+        return INF;
+    if (b + bq == 0)
+        return 0;
+    return (b + bq * king_coef) / (w + wq * king_coef);
+}
+
+//     
+struct Number_only_eval
+{
+    static constexpr const char *name = "NumberOnly";
+
+    static double score(const Position &pos, const bool first_bot_color, const Eval_weights &)
+    {
+        return material_ratio(pos.men_count[0], pos.king_count[0], pos.men_count[1], pos.king_count[1],
+                              first_bot_color, 4);
+    }
+
+    static void score_batch(const Leaf_batch &batch, const bool first_bot_color, const Eval_weights &, double *out)
+    {
+        material_ratio_batch(batch, first_bot_color, 0, 4, INF, out);
+    }
+};
+
+//     :     ,  
+struct Number_and_potential_eval
+{
+    static constexpr const char *name = "NumberAndPotential";
+
+    static double score(const Position &pos, const bool first_bot_color, const Eval_weights &)
+    {
+        return material_ratio(pos.men_count[0] + 0.05 * pos.potential[0], pos.king_count[0],
+                              pos.men_count[1] + 0.05 * pos.potential[1], pos.king_count[1], first_bot_color, 5);
+    }
+
+    static void score_batch(const Leaf_batch &batch, const bool first_bot_color, const Eval_weights &, double *out)
+    {
+        material_ratio_batch(batch, first_bot_color, 0.05, 5, INF, out);
+    }
+};
+
+//   ,  NumberAndPotential,     WeightsPath
+struct Weighted_eval
+{
+    static constexpr const char *name = "Weighted";
+
+    static double score(const Position &pos, const bool first_bot_color, const Eval_weights &w)
+    {
+        return material_ratio(pos.men_count[0] + w.potential * pos.potential[0], pos.king_count[0],
+                              pos.men_count[1] + w.potential * pos.potential[1], pos.king_count[1], first_bot_color,
+                              w.king_value);
+    }
+
+    static void score_batch(const Leaf_batch &batch, const bool first_bot_color, const Eval_weights &w, double *out)
+    {
+        material_ratio_batch(batch, first_bot_color, w.potential, w.king_value, INF, out);
+    }
+};
+
+//   (Nnue.h)     NnuePath.     ,   ,
+//  Logic     ,      score   score_batch
+struct Nnue_eval
+{
+    static constexpr const char *name = "Nnue";
+
+    //      ,     material_ratio: 1 - .
+    //          material_ratio
+    static double score(const Position &pos, const Nnue_network &net, const Nnue_accumulator &acc,
+                        const bool first_bot_color)
+    {
+        if (!pos.pieces(!first_bot_color))
+            return INF;
+        if (!pos.pieces(first_bot_color))
+            return 0;
+        const double max_logit = 12; //  ,         
+        const double z = std::min(std::max(net.logit(acc), -max_logit), max_logit); //  
+        return std::exp(first_bot_color ? -z : z);
+    }
+};
+
+//  ,   .  ,      
+using Evaluators_list = type_list<Number_only_eval, Number_and_potential_eval, Weighted_eval, Nnue_eval>;
+
+//     Optimization
+enum class Pruning
+{
+    O0, //    
+    O1, // - 
+    O2  // -      ,    
+};
+
+inline Pruning pruning_from_string(const std::string &name)
+{
+    if (name == "O0")
+        return Pruning::O0;
+    if (name == "O2")
+        return Pruning::O2;
+    return Pruning::O1;
+}
@@ -1,17 +1,21 @@
 #pragma once
 #include <chrono>
+#include <string>
 #include <thread>
 
 #include "../Models/Project_path.h"
+#include "Async_search.h"
 #include "Board.h"
 #include "Config.h"
 #include "Hand.h"
 #include "Logic.h"
+#include "Pdn.h"
+#include "Ponder.h"
 
 class Game
 {
 public:
-    Game() : board(config("WindowSize", "Width"), config("WindowSize", "Hight")), hand(&board), logic(&board, &config)
+    Game() : board(config("WindowSize", "Width"), config("WindowSize", "Hight")), hand(&board), logic(&config)
     {
         //    -    
         ofstream fout(project_path + "log.txt", ios_base::trunc);
@@ -27,7 +31,7 @@ public:
         //    ,    
         if (is_replay)
         {
-            logic = Logic(&board, &config); //     
+            logic = Logic(&config); //     
             config.reload(); //  
             board.redraw(); //  
         }
@@ -45,6 +49,7 @@ public:
         while (++turn_num < Max_turns)
         {
             beat_series = 0; //   
+            logic.set_position(Position(board.get_board())); //     
             logic.find_turns(turn_num % 2); //      
             //    ,  
             if (logic.turns.empty())
@@ -56,8 +61,26 @@ public:
             // ,     
             if (!config("Bot", string("Is") + string((turn_num % 2) ? "Black" : "White") + string("Bot")))
             {
+                //   ,        
+                const string opponent = (turn_num % 2) ? "White" : "Black";
+                if (config("Bot", "Ponder") && config("Bot", "Is" + opponent + "Bot"))
+                {
+                    ponder.start(logic, turn_num % 2, config("Bot", opponent + "BotLevel"));
+                    //   ,    ,     
+                    hand.set_idle(
+                        [this]() {
+                            board.set_title("pondering " + to_string(ponder.searched_num()) + "/" +
+                                            to_string(ponder.total_num()));
+                            return ponder.searched_num() < ponder.total_num();
+                        },
+                        250);
+                }
+
                 //  
                 auto resp = player_turn(turn_num % 2);
+                ponder.stop();
+                hand.set_idle(nullptr, 0);
+                board.set_title("");
 
                 //    : , ,   
                 if (resp == Response::QUIT)
@@ -74,7 +97,7 @@ public:
                 {
                     // ,     
                     if (config("Bot", string("Is") + string((1 - turn_num % 2) ? "Black" : "White") + string("Bot")) &&
-                        !beat_series && board.history_mtx.size() > 2)
+                        !beat_series && board.get_history().size() > 1)
                     {
                         board.rollback(); //  
                         --turn_num; //   
@@ -88,7 +111,20 @@ public:
                 }
             }
             else
-                bot_turn(turn_num % 2); //  
+            {
+                //  ,          
+                auto resp = bot_turn(turn_num % 2);
+                if (resp == Response::QUIT)
+                {
+                    is_quit = true;
+                    break;
+                }
+                if (resp == Response::REPLAY)
+                {
+                    is_replay = true;
+                    break;
+                }
+            }
         }
 
         //       
@@ -97,7 +133,9 @@ public:
         fout << "Game time: " << (int)chrono::duration<double, milli>(end - start).count() << " millisec\n"; //   
         fout.close();
 
-        //     
+        //     ,     
+        if (is_replay || is_quit)
+            save_game("*");
         if (is_replay)
             return play(); //   
         if (is_quit)
@@ -113,6 +151,7 @@ public:
         {
             res = 1; //  
         }
+        save_game(res == 1 ? "1-0" : res == 2 ? "0-1" : "1/2-1/2");
         board.show_final(res); //    
         auto resp = hand.wait(); //    
         if (resp == Response::REPLAY)
@@ -125,16 +164,41 @@ public:
 
 
 private:
-    //     
-    void bot_turn(const bool color)
+    //     :     ,      
+    //      .  QUIT  REPLAY,    ,  OK
+    Response bot_turn(const bool color)
     {
         auto start = chrono::steady_clock::now(); //    
 
-        auto delay_ms = config("Bot", "BotDelayMS"); //    
-        //       
-        thread th(SDL_Delay, delay_ms);
-        auto turns = logic.find_best_turns(color); //     
-        th.join(); //    
+        const int delay_ms = config("Bot", "BotDelayMS"); //    
+        //     ,       
+        vector<move_pos> turns;
+        const bool pondered = ponder.take(logic.get_position(), color, logic.Max_depth, turns);
+        if (!pondered)
+            search.start(logic, color);
+        //      BotDelayMS,      -  
+        while ((!pondered && !search.finished()) ||
+               chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() < delay_ms)
+        {
+            const Response resp = hand.poll_bot_turn(50);
+            if (resp == Response::QUIT || resp == Response::REPLAY)
+            {
+                search.abort();
+                board.set_title("");
+                return resp;
+            }
+            if (resp == Response::FORCE)
+                break;
+            search_info info;
+            bool updated = false;
+            while (search.poll(info))
+                updated = true;
+            if (updated)
+                board.set_title(progress_text(info));
+        }
+        if (!pondered)
+            turns = search.take();
+        board.set_title("");
 
         bool is_first = true; //     
         //   
@@ -142,7 +206,18 @@ private:
         {
             if (!is_first)
             {
-                SDL_Delay(delay_ms); //   
+                //   ,      
+                const auto step_start = chrono::steady_clock::now();
+                int left;
+                while ((left = delay_ms - int(chrono::duration<double, milli>(chrono::steady_clock::now() -
+                                                                               step_start).count())) > 0)
+                {
+                    const Response resp = hand.poll_bot_turn(left);
+                    if (resp == Response::QUIT || resp == Response::REPLAY)
+                        return resp;
+                    if (resp == Response::FORCE)
+                        break;
+                }
             }
             is_first = false; //  ,    
             beat_series += (turn.xb != -1); //   ,     
@@ -152,8 +227,18 @@ private:
         //      
         auto end = chrono::steady_clock::now();
         ofstream fout(project_path + "log.txt", ios_base::app);
-        fout << "Bot turn time: " << (int)chrono::duration<double, milli>(end - start).count() << " millisec\n";
+        fout << "Bot turn time: " << (int)chrono::duration<double, milli>(end - start).count() << " millisec"
+             << (pondered ? " (pondered)" : "") << "\n";
         fout.close();
+        return Response::OK;
+    }
+
+    //       : ,        PDN
+    static string progress_text(const search_info& info)
+    {
+        return "depth " + to_string(info.depth) + ", " + to_string(info.nodes) + " nodes, best " +
+               to_string(cell_index(info.best.x, info.best.y) + 1) + (info.best.xb != -1 ? "x" : "-") +
+               to_string(cell_index(info.best.x2, info.best.y2) + 1);
     }
 
 
@@ -260,6 +345,7 @@ private:
         while (true)
         {
             //      
+            logic.set_position(Position(board.get_board()));
             logic.find_turns(pos.x2, pos.y2);
             if (!logic.have_beats) //     
                 break; //   
@@ -312,6 +398,24 @@ private:
 
 
 private:
+    //       PdnPath   Game   PDN
+    void save_game(const string& result)
+    {
+        const string path = config("Game", "PdnPath");
+        if (path.empty() || !board.get_history().size())
+            return;
+        auto player = [&](const string& color) -> string {
+            if (!config("Bot", "Is" + color + "Bot"))
+                return "Player";
+            return "Bot level " + to_string(int(config("Bot", color + "BotLevel")));
+        };
+        ofstream fout(project_path + path, ios_base::app);
+        fout << pdn_write(board.get_history(),
+                          { { "Event", "Checkers" }, { "Date", pdn_date() }, { "White", player("White") },
+                            { "Black", player("Black") } },
+                          result);
+    }
+
     Config config; //      ,    ,   ..
 
     Board board; //           .
@@ -320,6 +424,10 @@ private:
 
     Logic logic; // ,      ,        .
 
+    Ponder ponder; //   ,   .
+
+    Async_search search; //      ,    .
+
     int beat_series; // ,      ;      .
 
     bool is_replay = false; // , ,        (,        ).
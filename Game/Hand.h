@@ -1,11 +1,15 @@
 #pragma once
+#include <chrono>
+#include <functional>
 #include <tuple>
 
 #include "../Models/Move.h"
 #include "../Models/Response.h"
 #include "Board.h"
 
-//      
+//      .      :    SDL_WaitEvent,
+//   .     (set_idle),    ,  
+//   ,   ,    
 class Hand
 {
 public:
@@ -23,55 +27,56 @@ public:
         int x = -1, y = -1; //    
         int xc = -1, yc = -1; //     
 
-        //     
+        //   
         while (true)
         {
-            if (SDL_PollEvent(&windowEvent)) //    
+            wait_event(windowEvent); //   
+            switch (windowEvent.type)
             {
-                switch (windowEvent.type)
-                {
-                case SDL_QUIT:
-                    resp = Response::QUIT; //      
-                    break;
-                case SDL_MOUSEBUTTONDOWN:
-                    //     
-                    x = windowEvent.motion.x;
-                    y = windowEvent.motion.y;
+            case SDL_QUIT:
+                resp = Response::QUIT; //      
+                break;
+            case SDL_MOUSEBUTTONDOWN:
+                //     
+                x = windowEvent.motion.x;
+                y = windowEvent.motion.y;
 
-                    //     
-                    xc = int(y / (board->H / 10) - 1);
-                    yc = int(x / (board->W / 10) - 1);
+                //     
+                xc = int(y / (board->H / 10) - 1);
+                yc = int(x / (board->W / 10) - 1);
 
-                    //    ,    
-                    if (xc == -1 && yc == -1 && board->history_mtx.size() > 1)
-                    {
-                        resp = Response::BACK; //  
-                    }
-                    else if (xc == -1 && yc == 8)
-                    {
-                        resp = Response::REPLAY; //  
-                    }
-                    else if (xc >= 0 && xc < 8 && yc >= 0 && yc < 8)
-                    {
-                        resp = Response::CELL; //    
-                    }
-                    else
-                    {
-                        xc = -1; //      
-                        yc = -1;
-                    }
-                    break;
-                case SDL_WINDOWEVENT:
-                    //    
-                    if (windowEvent.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
-                    {
-                        board->reset_window_size(); //   
-                        break;
-                    }
+                //    ,    
+                if (xc == -1 && yc == -1 && board->get_history().can_undo())
+                {
+                    resp = Response::BACK; //  
+                }
+                else if (xc == -1 && yc == 8)
+                {
+                    resp = Response::REPLAY; //  
+                }
+                else if (xc >= 0 && xc < 8 && yc >= 0 && yc < 8)
+                {
+                    resp = Response::CELL; //    
+                }
+                else
+                {
+                    xc = -1; //      
+                    yc = -1;
                 }
-                if (resp != Response::OK) //   ,   
+                break;
+            case SDL_WINDOWEVENT:
+                //    
+                if (windowEvent.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+                {
+                    board->reset_window_size(); //   
                     break;
+                }
+                if (windowEvent.window.event == SDL_WINDOWEVENT_EXPOSED)
+                    board->invalidate(); //     -   
+                break;
             }
+            if (resp != Response::OK) //   ,   
+                break;
         }
         return { resp, xc, yc }; //     
     }
@@ -82,38 +87,116 @@ public:
         SDL_Event windowEvent; //     SDL
         Response resp = Response::OK; //   
 
-        //    
+        //   
         while (true)
         {
-            if (SDL_PollEvent(&windowEvent)) //    
+            wait_event(windowEvent); //   
+            switch (windowEvent.type)
             {
-                switch (windowEvent.type)
-                {
-                case SDL_QUIT:
-                    resp = Response::QUIT; //      
-                    break;
-                case SDL_WINDOWEVENT_SIZE_CHANGED:
+            case SDL_QUIT:
+                resp = Response::QUIT; //      
+                break;
+            case SDL_WINDOWEVENT:
+                //   
+                if (windowEvent.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+                    board->reset_window_size();
+                else if (windowEvent.window.event == SDL_WINDOWEVENT_EXPOSED)
+                    board->invalidate();
+                break;
+            case SDL_MOUSEBUTTONDOWN: {
+                //     
+                int x = windowEvent.motion.x;
+                int y = windowEvent.motion.y;
+                int xc = int(y / (board->H / 10) - 1);
+                int yc = int(x / (board->W / 10) - 1);
+                if (xc == -1 && yc == 8)
+                    resp = Response::REPLAY; //    ""
+            }
+                                    break;
+            }
+            if (resp != Response::OK) //   ,   
+                break;
+        }
+        return resp; //  
+    }
 
-                    board->reset_window_size(); //   
+    //    ,    :     timeout_ms  
+    //  .  QUIT, REPLAY, FORCE (     -  )
+    //  OK,      
+    Response poll_bot_turn(const int timeout_ms) const
+    {
+        SDL_Event windowEvent; //     SDL
+        Response resp = Response::OK;
+        board->present();
+        if (!SDL_WaitEventTimeout(&windowEvent, timeout_ms))
+            return resp; //      
+        do
+        {
+            switch (windowEvent.type)
+            {
+            case SDL_QUIT:
+                return Response::QUIT;
+            case SDL_KEYDOWN:
+                if (windowEvent.key.keysym.sym == SDLK_SPACE)
+                    resp = Response::FORCE;
+                break;
+            case SDL_MOUSEBUTTONDOWN: {
+                const int xc = int(windowEvent.motion.y / (board->H / 10) - 1);
+                const int yc = int(windowEvent.motion.x / (board->W / 10) - 1);
+                if (xc == -1 && yc == 8)
+                    return Response::REPLAY; //   ""
+                if (xc >= 0 && xc < 8 && yc >= 0 && yc < 8)
+                    resp = Response::FORCE;
+                break;
+            }
+            case SDL_WINDOWEVENT:
+                if (windowEvent.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+                    board->reset_window_size();
+                else if (windowEvent.window.event == SDL_WINDOWEVENT_EXPOSED)
+                    board->invalidate();
+                break;
+            }
+        } while (SDL_PollEvent(&windowEvent));
+        return resp;
+    }
+
+    //     ,        ,  
+    //  period_ms.   false,    ; nullptr -  
+    void set_idle(function<bool()> task, const int period_ms)
+    {
+        idle = move(task);
+        idle_period = chrono::milliseconds(period_ms);
+        next_idle = chrono::steady_clock::now();
+    }
+
+private:
+    //     .       ,
+    //   -     
+    void wait_event(SDL_Event& windowEvent) const
+    {
+        while (idle)
+        {
+            const auto now = chrono::steady_clock::now();
+            if (now >= next_idle)
+            {
+                if (!idle())
+                {
+                    idle = nullptr; //  ,    
                     break;
-                case SDL_MOUSEBUTTONDOWN: {
-                    //     
-                    int x = windowEvent.motion.x;
-                    int y = windowEvent.motion.y;
-                    int xc = int(y / (board->H / 10) - 1);
-                    int yc = int(x / (board->W / 10) - 1);
-                    if (xc == -1 && yc == 8)
-                        resp = Response::REPLAY; //    ""
                 }
-                                        break;
-                }
-                if (resp != Response::OK) //   ,   
-                    break;
+                next_idle = now + idle_period;
             }
+            board->present(); //       
+            const auto timeout = chrono::duration_cast<chrono::milliseconds>(next_idle - now).count();
+            if (SDL_WaitEventTimeout(&windowEvent, int(max<long long>(1, timeout))))
+                return;
         }
-        return resp; //  
+        board->present();
+        SDL_WaitEvent(&windowEvent);
     }
 
-private:
     Board* board; //        
+    mutable function<bool()> idle; //      
+    chrono::milliseconds idle_period{0}; //   
+    mutable chrono::steady_clock::time_point next_idle; //    
 };
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <stddef.h>
+
+//   :           ,  
+//      ,   .     
+//     ,    ,   .
+
+//     .          (Logic.h)
+const int LEAF_BATCH_MAX = 64;
+
+//        ,  0 - 
+struct Leaf_batch
+{
+    size_t size = 0;
+    double men[2][LEAF_BATCH_MAX];
+    double kings[2][LEAF_BATCH_MAX];
+    double potential[2][LEAF_BATCH_MAX];
+};
+
+//    , first_bot_color -   material_ratio:    (opp)
+//    (own)
+inline void material_ratio_batch(const Leaf_batch &batch, const bool first_bot_color, const double potential_coef,
+                                 const double king_coef, const double win_score, double *out)
+{
+    const int own = first_bot_color ? 0 : 1;
+    const int opp = !own;
+    for (size_t i = 0; i < batch.size; ++i)
+    {
+        const double w = batch.men[own][i] + potential_coef * batch.potential[own][i], wq = batch.kings[own][i];
+        const double b = batch.men[opp][i] + potential_coef * batch.potential[opp][i], bq = batch.kings[opp][i];
+        if (w + wq == 0)
+            out[i] = win_score;
+        else if (b + bq == 0)
+            out[i] = 0;
+        else
+            out[i] = (b + bq * king_coef) / (w + wq * king_coef);
+    }
+}
@@ -1,37 +1,187 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <random>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "../Models/Move.h"
-#include "Board.h"
+#include "../Models/Position.h"
 #include "Config.h"
+#include "Evaluators.h"
+#include "Opening_book.h"
+#include "Tablebase.h"
+#include "Trans_table.h"
 
-const int INF = 1e9;
+using namespace std;
+
+//         
+struct search_info
+{
+    int depth = 0;                            //   
+    size_t nodes = 0;                         //       
+    double ms = 0;                            //      
+    double score = 0;                         //       
+    move_pos best = move_pos(-1, -1, -1, -1); //    (   )
+    vector<vector<move_pos>> pv;              //  :  ,    
+};
 
 class Logic
 {
   public:
- //   Logic,     Board  Config
-    Logic(Board *board, Config *config) : board(board), config(config)
+ //   Logic,     Config
+    //     SDL  :    set_position
+    Logic(Config *config) : config(config)
     {
         rand_eng = std::default_random_engine (
             !((*config)("Bot", "NoRandom")) ? unsigned(time(0)) : 0);
-        scoring_mode = (*config)("Bot", "BotScoringType");
-        optimization = (*config)("Bot", "Optimization");
+        //     ,         
+        string scoring_mode = (*config)("Bot", "BotScoringType");
+        const string nnue_path = (*config)("Bot", "NnuePath");
+        if (!nnue_path.empty())
+        {
+            auto net = make_shared<Nnue_network>();
+            if (net->load(project_path + nnue_path))
+                nnue = net;
+        }
+        if (scoring_mode == Nnue_eval::name && !nnue)
+            scoring_mode = Number_and_potential_eval::name; //    -   
+        select_search(scoring_mode, pruning_from_string((*config)("Bot", "Optimization")), Evaluators_list());
+        const string weights_path = (*config)("Bot", "WeightsPath");
+        if (!weights_path.empty())
+            load_weights(project_path + weights_path, weights); //      
+        tt = make_shared<Trans_table>();
+        tt->resize((*config)("Bot", "HashSizeMB"));
+        move_time_ms = (*config)("Bot", "MoveTimeMS");
+        const string tablebase_path = (*config)("Bot", "TablebasePath");
+        if (!tablebase_path.empty())
+        {
+            auto tb = make_shared<Tablebase>();
+            if (tb->open(project_path + tablebase_path))
+                tablebase = tb; //        
+        }
+        const string book_path = (*config)("Bot", "BookPath");
+        if (!book_path.empty())
+        {
+            auto bk = make_shared<Opening_book>();
+            if (bk->open(project_path + book_path))
+                book = bk;
+        }
+        threads_num = (*config)("Bot", "Threads");
+        if (threads_num <= 0)
+            threads_num = max(1, int(thread::hardware_concurrency())); // 0 -   
+    }
+
+    //    ,       
+    void set_position(const Position &pos)
+    {
+        position = pos;
+    }
+
+    //     
+    const Position &get_position() const
+    {
+        return position;
+    }
+
+    //       
+    void make_turn(const move_pos turn)
+    {
+        position.make_turn(turn);
+    }
+
+    //         :    
+    //       
+    void set_stop_flag(const atomic<bool> *flag)
+    {
+        external_stop = flag;
+    }
+
+    //    ,         .
+    //     , nullptr -  
+    void set_progress(function<void(const search_info &)> callback)
+    {
+        on_iteration = move(callback);
+    }
+
+    //       , 0 -  
+    void set_move_time(const int ms)
+    {
+        move_time_ms = ms;
     }
-    //         true - , false - 
+
+    //          , 0 -  .
+    //    ,        
+    void set_node_limit(const size_t limit)
+    {
+        node_limit = limit;
+    }
+
+    //      color        
+    //  :    , false -    
+    bool expected_turn(const bool color, move_pos &turn) const
+    {
+        tt_entry e;
+        if (!tt->probe(tt_key(position, color), e) || e.best.x == -1)
+            return false;
+        turn = e.best;
+        return true;
+    }
+    //         false - , true - 
+    //   MoveTimeMS     Max_depth    
     vector<move_pos> find_best_turns(const bool color)
     {
-        next_best_state.clear(); //   
-        next_move.clear(); //   
+        start_time = chrono::steady_clock::now();
+
+        //      -      
+        vector<move_pos> book_res;
+        if (book && find_book_turn(color, book_res))
+        {
+            nodes = 0;
+            last_depth = 0;
+            return book_res;
+        }
+
+        // Lazy SMP:            
+        //   ,     .  Threads = 1  
+        atomic<bool> helpers_stop(false);
+        vector<Logic> helpers;
+        helpers.reserve(threads_num - 1);
+        for (int i = 1; i < threads_num; ++i)
+        {
+            helpers.push_back(*this); //        
+            Logic &helper = helpers.back();
+            helper.external_stop = &helpers_stop;
+            helper.move_time_ms = 0; //       
+            helper.node_limit = 0;
+            helper.on_iteration = nullptr; //       
+            helper.rand_eng.seed(unsigned(rand_eng() + i)); //     
+        }
+        vector<thread> workers;
+        for (int i = 1; i < threads_num; ++i)
+            workers.emplace_back(&Logic::search_turns, &helpers[i - 1], color, i % 2);
+
+        //           .   
+        //  ,    ,         
+        search_turns(color, move_time_ms || node_limit || external_stop ? 0 : Max_depth);
 
-        //    
-        vector<vector<POS_T>> mtx = board->get_board(); //   
-        double score = find_first_best_turn(mtx, color, -1, -1, 0, -1); //        
+        helpers_stop = true;
+        for (auto &worker : workers)
+            worker.join();
+        for (auto &helper : helpers)
+            nodes += helper.nodes;
 
         //   
         int cur_state = 0; //  
         vector<move_pos> res; //     
+        if (next_move.empty())
+            return res; //   
 
         // ,    ,    
         do
@@ -46,78 +196,121 @@ class Logic
 
 
 private:
-    //        
-    vector<vector<POS_T>> make_turn(vector<vector<POS_T>> mtx, move_pos turn) const
-    {
-        if (turn.xb != -1)
-            mtx[turn.xb][turn.yb] = 0;
-        if ((mtx[turn.x][turn.y] == 1 && turn.x2 == 0) || (mtx[turn.x][turn.y] == 2 && turn.x2 == 7))
-            mtx[turn.x][turn.y] += 2;
-        mtx[turn.x2][turn.y2] = mtx[turn.x][turn.y];
-        mtx[turn.x][turn.y] = 0;
-        return mtx;
-    }
-    //     ,     
-    double calc_score(const vector<vector<POS_T>> &mtx, const bool first_bot_color) const
-    {
-        // color - who is max player
-    // color -   
-        double w = 0, wq = 0, b = 0, bq = 0; //      
-        for (POS_T i = 0; i < 8; ++i)
+    //        start_depth  Max_depth
+    //       next_move  next_best_state
+    void search_turns(const bool color, const int start_depth)
+    {
+        nodes = 0; //   
+        last_depth = 0;
+        bot_color = color; //          
+        stop = false;
+        can_stop = false; //      
+        pv_turn = move_pos(-1, -1, -1, -1);
+
+        const int full_depth = Max_depth;
+        // Killer-    ,  ,     
+        killers.assign(2 * (full_depth + 1), move_pos(-1, -1, -1, -1));
+        for (auto &h : history)
+            h /= 2;
+        vector<move_pos> done_move; //    
+        vector<int> done_state;
+        Position work = position; // ,       
+        undo_stack.clear();
+        undo_stack.reserve(256);
+        for (int depth = min(start_depth, full_depth); depth <= full_depth; ++depth)
         {
-            for (POS_T j = 0; j < 8; ++j)
+            Max_depth = depth;
+            next_best_state.clear(); //   
+            next_move.clear(); //   
+            const double score = (this->*root_search)(work, color, -1, -1, 0, -1); //       
+            if (stop)
+                break; //   
+
+            done_move.swap(next_move);
+            done_state.swap(next_best_state);
+            last_depth = depth;
+            pv_turn = done_move[0]; //       
+            can_stop = true;
+            if (on_iteration)
             {
-                w += (mtx[i][j] == 1);
-                wq += (mtx[i][j] == 3);
-                b += (mtx[i][j] == 2);
-                bq += (mtx[i][j] == 4);
-                if (scoring_mode == "NumberAndPotential")
-                {
-                    w += 0.05 * (mtx[i][j] == 1) * (7 - i);
-                    b += 0.05 * (mtx[i][j] == 2) * (i);
-                }
+                search_info info;
+                info.depth = depth;
+                info.nodes = nodes;
+                info.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start_time).count();
+                info.score = score;
+                info.best = pv_turn;
+                info.pv = principal_variation(done_move, done_state, color, depth + 1);
+                on_iteration(info);
             }
+            if (need_stop())
+                break;
         }
-        if (!first_bot_color)
-        {
-            swap(b, w);
-            swap(bq, wq);
-        }
-        if (w + wq == 0)
-            return INF;
-        if (b + bq == 0)
-            return 0;
-        int q_coef = 4; //   
+        Max_depth = full_depth;
+        next_move.swap(done_move);
+        next_best_state.swap(done_state);
+    }
+
+    //    ,       
+    typedef double (Logic::*root_search_fn)(Position &, const bool, const POS_T, const POS_T, size_t, double);
 
-        if (scoring_mode == "NumberAndPotential")
+    //         :   Evaluators_list,
+    //       
+    template <class Eval, class... Rest>
+    void select_search(const string &name, const Pruning pruning, type_list<Eval, Rest...>)
+    {
+        if (!root_search || name == Eval::name)
         {
-            q_coef = 5;
+            if (pruning == Pruning::O0)
+                root_search = &Logic::find_first_best_turn<Eval, Pruning::O0>;
+            else if (pruning == Pruning::O2)
+                root_search = &Logic::find_first_best_turn<Eval, Pruning::O2>;
+            else
+                root_search = &Logic::find_first_best_turn<Eval, Pruning::O1>;
         }
-        return (b + bq * q_coef) / (w + wq * q_coef);
+        select_search(name, pruning, type_list<Rest...>());
+    }
+    void select_search(const string &, const Pruning, type_list<>)
+    {
     }
 
-    double find_first_best_turn(vector<vector<POS_T>> mtx, const bool color, const POS_T x, const POS_T y, size_t state,
+    //     ,   ,    
+    template <class Eval, Pruning Prune>
+    double find_first_best_turn(Position &pos, const bool color, const POS_T x, const POS_T y, size_t state,
         double alpha = -1)
     {
-        //  ,   
-        if (state == 0) {
-            next_best_state.clear();
-            next_move.clear();
-        }
-
+        ++nodes;
         next_best_state.push_back(-1);
         next_move.emplace_back(-1, -1, -1, -1); //   ,    
-
-        double best_score = -INF; //        
-
-        //      
-        find_turns(x, y, mtx);
-        auto turns_now = turns;
+        double best_score = -1;
+
+        if (state == 0)
+            eval_root(pos, type_list<Eval>());
+
+        //      ,    -    
+        if (state != 0)
+            find_turns(x, y, pos);
+        else
+            find_turns(color, pos);
+        vector<move_pos> &turns_now = ply_turns(); //        
+        turns_now.assign(turns.begin(), turns.end());
         bool have_beats_now = have_beats;
 
-        //       ,     
-        if (turns_now.empty()) {
-            return calc_score(mtx, color);
+        //    -    
+        if (!have_beats_now && state != 0)
+        {
+            return find_best_turns_rec<Eval, Prune>(pos, !color, 0, alpha);
+        }
+
+        //       ,     
+        //      
+        const uint64_t key = tt_key(pos, color);
+        if (state == 0)
+        {
+            shuffle(turns_now.begin(), turns_now.end(), rand_eng);
+            tt_entry e;
+            if (tt->probe(key, e))
+                put_first(turns_now, e.best);
+            put_first(turns_now, pv_turn);
         }
 
         //    
@@ -125,206 +318,620 @@ private:
             size_t next_state = next_move.size(); //    
             double score;
 
-            //      
-            vector<vector<POS_T>> new_mtx = make_turn(mtx, turn);
-
-            //   ,      
+            search_make(pos, turn, type_list<Eval>());
+            //   ,     
             if (have_beats_now) {
-                score = find_first_best_turn(new_mtx, color, turn.x2, turn.y2, next_state);
+                score = find_first_best_turn<Eval, Prune>(pos, color, turn.x2, turn.y2, next_state, best_score);
             }
             else {
-                //     
-                score = -find_first_best_turn(new_mtx, !color, 0, -1, next_state);
+                //     
+                score = find_best_turns_rec<Eval, Prune>(pos, !color, 0, best_score);
             }
+            pos.unmake_turn(turn, undo_stack.back());
+            undo_stack.pop_back();
 
             //   ,   
             if (score > best_score) {
                 best_score = score;
-                next_best_state[state] = next_state; //  ,     
+                next_best_state[state] = (have_beats_now ? int(next_state) : -1); //  ,   
                 next_move[state] = turn; //    
             }
+            if (stop)
+                return best_score; //  ,    
+        }
+
+        //        ,   find_best_turns_rec  depth = 0
+        if (state == 0)
+            tt->store(key, tt_score_to(best_score, -1), Max_depth + 1, Bound::EXACT, next_move[state]);
+        return best_score; //      
+    }
 
-            // -  -   
-            if (alpha != -1 && best_score >= alpha) {
-                break; //     ,   
+    //   - , depth -      
+    template <class Eval, Pruning Prune>
+    double find_best_turns_rec(Position &pos, const bool color, const size_t depth,
+        double alpha = -1, double beta = INF + 1, const POS_T x = -1, const POS_T y = -1)
+    {
+        ++nodes;
+        //  ,      
+        if ((nodes & 1023) == 0 && need_stop())
+            stop = true;
+        if (stop)
+            return 0;
+        //      -    
+        if (x == -1 && in_tablebase(pos))
+        {
+            tb_outcome outcome;
+            int plies;
+            if (tablebase->probe(pos, color, outcome, plies))
+                return tablebase_score(outcome, plies, depth);
+        }
+        //    -      
+        if (depth == size_t(Max_depth)) {
+            return eval_leaf(pos, (depth % 2 == color), type_list<Eval>()); //    
+        }
+
+        //       ,    
+        const uint64_t key = tt_key(pos, color);
+        const int rest = Max_depth - int(depth); //  
+        move_pos tt_turn(-1, -1, -1, -1);
+        if (x == -1)
+        {
+            tt_entry e;
+            if (tt->probe(key, e))
+            {
+                e.score = tt_score_from(e.score, int(depth));
+                if (e.depth >= rest && (e.bound == Bound::EXACT || (e.bound == Bound::LOWER && e.score >= beta) ||
+                                        (e.bound == Bound::UPPER && e.score <= alpha)))
+                    return e.score; //      
+                tt_turn = e.best;
             }
         }
 
-        return best_score; //      
+        //   :    -    
+        if (x != -1)
+            find_turns(x, y, pos);
+        else
+            find_turns(color, pos);
+        vector<move_pos> &turns_now = ply_turns(); //        
+        turns_now.assign(turns.begin(), turns.end());
+        bool have_beats_now = have_beats;
+
+        //    -    
+        if (!have_beats_now && x != -1) {
+            return find_best_turns_rec<Eval, Prune>(pos, !color, depth + 1, alpha, beta);
+        }
+
+        //   -  ,   
+        if (turns_now.empty()) {
+            return (depth % 2 ? 0 : INF);
+        }
+
+        //       ,    , killer-  
+        order_turns(turns_now, pos, color, depth, tt_turn);
+        const double alpha_now = alpha, beta_now = beta; //      
+        move_pos best_turn(-1, -1, -1, -1);
+
+        //        -    ,   
+        const bool leaves_batch = !have_beats_now && x == -1 && depth + 1 == size_t(Max_depth) &&
+                                  turns_now.size() <= size_t(LEAF_BATCH_MAX) && !in_tablebase(pos);
+        if (leaves_batch)
+            eval_leaves(turns_now, pos, color, (depth + 1) % 2 == size_t(!color), type_list<Eval>());
+
+        double min_score = INF + 1;
+        double max_score = -1;
+        for (size_t i = 0; i < turns_now.size(); ++i) {
+            const move_pos &turn = turns_now[i];
+            double score;
+            if (leaves_batch)
+            {
+                //       ,    
+                ++nodes;
+                if ((nodes & 1023) == 0 && need_stop())
+                    stop = true;
+                score = stop ? 0 : leaf_scores[i];
+            }
+            else
+            {
+                search_make(pos, turn, type_list<Eval>());
+                if (!have_beats_now && x == -1)
+                    score = find_best_turns_rec<Eval, Prune>(pos, !color, depth + 1, alpha, beta); //  
+                else
+                    score = find_best_turns_rec<Eval, Prune>(pos, color, depth, alpha, beta, turn.x2, turn.y2); //   
+                pos.unmake_turn(turn, undo_stack.back());
+                undo_stack.pop_back();
+            }
+
+            //     ,   
+            if ((depth % 2 && score > max_score) || (!(depth % 2) && score < min_score))
+                best_turn = turn;
+            min_score = std::min(min_score, score);
+            max_score = std::max(max_score, score);
+            // - :      (),   - 
+            if (depth % 2)
+                alpha = std::max(alpha, max_score);
+            else
+                beta = std::min(beta, min_score);
+            if (Prune != Pruning::O0 && alpha >= beta)
+            {
+                //  ,  ,      
+                if (!have_beats_now)
+                    remember_cutoff(turn, color, depth, rest);
+                break;
+            }
+            if (Prune == Pruning::O2 && alpha == beta)
+                return (depth % 2 ? max_score + 1 : min_score - 1);
+        }
+
+        const double best_score = (depth % 2 ? max_score : min_score);
+        if (x == -1 && !stop) //     
+        {
+            const Bound bound = best_score <= alpha_now ? Bound::UPPER : (best_score >= beta_now ? Bound::LOWER : Bound::EXACT);
+            tt->store(key, tt_score_to(best_score, int(depth)), rest, bound, best_turn);
+        }
+        return best_score; //      
+    }
+
+
+    //   .        ,   
+    //         :   
+    // k     acc_stack[k],      
+
+    //       
+    template <class Eval> void eval_root(const Position &, type_list<Eval>)
+    {
+    }
+    void eval_root(const Position &pos, type_list<Nnue_eval>)
+    {
+        const size_t ply = undo_stack.size();
+        if (acc_stack.size() <= ply)
+            acc_stack.resize(ply + 1);
+        nnue->refresh(pos, acc_stack[ply]);
+    }
+
+    //      ,   pos.unmake_turn(turn, undo_stack.back())
+    template <class Eval> void search_make(Position &pos, const move_pos &turn, type_list<Eval>)
+    {
+        undo_stack.push_back(pos.make_turn(turn));
+    }
+    void search_make(Position &pos, const move_pos &turn, type_list<Nnue_eval>)
+    {
+        undo_stack.push_back(pos.make_turn(turn));
+        const undo_info &undo = undo_stack.back();
+        const size_t ply = undo_stack.size();
+        if (acc_stack.size() <= ply)
+            acc_stack.resize(ply + 1);
+        const int s = cell_index(turn.x, turn.y), s2 = cell_index(turn.x2, turn.y2);
+        const POS_T type = pos.get(s2);
+        nnue->update(acc_stack[ply - 1], acc_stack[ply], nnue_feature(type, s2),
+                     nnue_feature(undo.promoted ? type - 2 : type, s),
+                     undo.beaten ? nnue_feature(undo.beaten, cell_index(turn.xb, turn.yb)) : -1);
     }
 
-    double find_best_turns_rec(vector<vector<POS_T>> mtx, const bool color, const size_t depth,
-        double alpha = -INF, double beta = INF, const POS_T x = -1, const POS_T y = -1)
+    //        
+    template <class Eval> double eval_leaf(const Position &pos, const bool first_bot_color, type_list<Eval>)
     {
-        //    (,      )
-        if (depth == 0) {
-            return calc_score(mtx, color); //    
+        return Eval::score(pos, first_bot_color, weights);
+    }
+    double eval_leaf(const Position &pos, const bool first_bot_color, type_list<Nnue_eval>)
+    {
+        return Nnue_eval::score(pos, *nnue, acc_stack[undo_stack.size()], first_bot_color);
+    }
+
+    //        turns_list   ,  -  leaf_scores
+    template <class Eval>
+    void eval_leaves(const vector<move_pos> &turns_list, const Position &pos, const bool color,
+                     const bool first_bot_color, type_list<Eval>)
+    {
+        fill_leaf_batch(turns_list, pos, color);
+        Eval::score_batch(leaf_batch, first_bot_color, weights, leaf_scores);
+    }
+    //           ,
+    //      
+    void eval_leaves(const vector<move_pos> &turns_list, const Position &pos, const bool color,
+                     const bool first_bot_color, type_list<Nnue_eval>)
+    {
+        const Nnue_accumulator &acc = acc_stack[undo_stack.size()];
+        Nnue_accumulator leaf_acc;
+        for (size_t i = 0; i < turns_list.size(); ++i)
+        {
+            const move_pos &turn = turns_list[i];
+            const int s = cell_index(turn.x, turn.y), s2 = cell_index(turn.x2, turn.y2);
+            const POS_T type = pos.get(s);
+            const bool promoted = type <= 2 && (color ? turn.x2 == 7 : turn.x2 == 0);
+            nnue->update(acc, leaf_acc, nnue_feature(promoted ? type + 2 : type, s2), nnue_feature(type, s), -1);
+            leaf_scores[i] = Nnue_eval::score(pos, *nnue, leaf_acc, first_bot_color);
         }
+    }
 
-        bool have_moves = false; //   ,    
-        double best_score;
+    //       (  ),    
+    vector<move_pos> &ply_turns()
+    {
+        const size_t ply = undo_stack.size();
+        while (turn_stack.size() <= ply)
+            turn_stack.emplace_back(); // deque     
+        return turn_stack[ply];
+    }
 
-        //   
-        find_turns(x, y, mtx); // ,   `find_turns`      `turns`
+    //       :      .
+    //       ,   ( )  false
+    bool find_book_turn(const bool color, vector<move_pos> &res)
+    {
+        const auto range = book->probe(book_key(position, color));
+        uint64_t total = 0;
+        for (auto e = range.first; e != range.second; ++e)
+            total += e->points;
+        if (!total)
+            return false;
+        uint64_t r = uniform_int_distribution<uint64_t>(0, total - 1)(rand_eng);
+        auto pick = range.first;
+        while (r >= pick->points)
+            r -= (pick++)->points;
+
+        const Rays &rs = rays();
+        Position pos = position;
+        res.clear();
+        for (int i = 1; i < BOOK_PATH_LEN && pick->path[i] != BOOK_NO_CELL; ++i)
+        {
+            const int from = pick->path[i - 1], to = pick->path[i];
+            if (i == 1)
+                find_turns(color, pos);
+            else
+                find_turns(rs.x[from], rs.y[from], pos);
+            auto it = find_if(turns.begin(), turns.end(), [&](const move_pos &t) {
+                return cell_index(t.x, t.y) == from && cell_index(t.x2, t.y2) == to && (i == 1 || (have_beats && res.back().xb != -1));
+            });
+            if (it == turns.end())
+                return false;
+            res.push_back(*it);
+            pos.make_turn(*it);
+        }
+        if (res.empty())
+            return false;
+        //       
+        if (res.back().xb != -1)
+        {
+            find_turns(res.back().x2, res.back().y2, pos);
+            if (have_beats)
+                return false;
+        }
+        return true;
+    }
 
-        if (turns.empty()) {
-            return calc_score(mtx, color); //    ,  
+    //            turns_list:
+    //           
+    void fill_leaf_batch(const vector<move_pos> &turns_list, const Position &pos, const bool color)
+    {
+        leaf_batch.size = turns_list.size();
+        for (size_t i = 0; i < turns_list.size(); ++i)
+        {
+            for (int c = 0; c < 2; ++c)
+            {
+                leaf_batch.men[c][i] = pos.men_count[c];
+                leaf_batch.kings[c][i] = pos.king_count[c];
+                leaf_batch.potential[c][i] = pos.potential[c];
+            }
+            const move_pos &turn = turns_list[i];
+            const int s = cell_index(turn.x, turn.y), s2 = cell_index(turn.x2, turn.y2);
+            if (pos.kings >> s & 1)
+                continue;
+            if (color ? turn.x2 == 7 : turn.x2 == 0)
+            {
+                leaf_batch.men[color][i] -= 1;
+                leaf_batch.kings[color][i] += 1;
+                leaf_batch.potential[color][i] -= Position::advance(color, s);
+            }
+            else
+                leaf_batch.potential[color][i] += Position::advance(color, s2) - Position::advance(color, s);
         }
+    }
 
-        if (color) {
-            best_score = -INF; //    
-            for (const auto& turn : turns) {
-                have_moves = true; //  
-                vector<vector<POS_T>> new_mtx = make_turn(mtx, turn); //      
-                double score = find_best_turns_rec(new_mtx, !color, depth - 1, alpha, beta, turn.x2, turn.y2); //     
+    //         
+    bool in_tablebase(const Position &pos) const
+    {
+        return tablebase &&
+               pos.men_count[0] + pos.men_count[1] + pos.king_count[0] + pos.king_count[1] <= tablebase->pieces();
+    }
 
-                best_score = std::max(best_score, score); //   
-                alpha = std::max(alpha, best_score); //  
+    //   ,    :       
+    // (   ).      ,    
+    bool need_stop() const
+    {
+        return can_stop && (time_over() || (external_stop && external_stop->load(memory_order_relaxed)));
+    }
+
+    //       .  -  :    
+    // 2 * TB_MAX_DISTANCE   ,    tt_score_to/tt_score_from  
+    static constexpr double TB_LOSS_STEP = 1.0 / (1ull << 32);
+    static constexpr double TB_MAX_DISTANCE = 1024; //          
 
-                if (beta <= alpha) { // --
-                    break; // ,     
+    //         :     .
+    //    ,    ,  -   .
+    //     Nnue_eval,       tt_score_to
+    double tablebase_score(const tb_outcome outcome, const int plies, const size_t depth) const
+    {
+        if (outcome == tb_outcome::DRAW)
+            return 1;
+        const double distance = double(depth + plies);
+        if ((outcome == tb_outcome::WIN) == bool(depth % 2))
+            return INF - distance;
+        return distance * TB_LOSS_STEP;
+    }
+
+    //         ,    
+    // ,       .       
+    //   depth ( -  -1):      ,   .
+    //       depth + 1,      INF
+    static bool is_tablebase_win(const double score)
+    {
+        return score >= INF - TB_MAX_DISTANCE && score < INF;
+    }
+
+    static bool is_tablebase_loss(const double score)
+    {
+        return score > 0 && score <= TB_MAX_DISTANCE * TB_LOSS_STEP;
+    }
+
+    static double tt_score_to(const double score, const int depth)
+    {
+        if (is_tablebase_win(score))
+            return score + depth;
+        if (is_tablebase_loss(score))
+            return score - depth * TB_LOSS_STEP;
+        return score;
+    }
+
+    static double tt_score_from(const double score, const int depth)
+    {
+        if (is_tablebase_win(score))
+            return score - depth;
+        if (is_tablebase_loss(score))
+            return score + depth * TB_LOSS_STEP;
+        return score;
+    }
+
+    //     :   -    , 
+    //     ,   plies  .    
+    //   ,     ,    -
+    vector<vector<move_pos>> principal_variation(const vector<move_pos> &first_move, const vector<int> &first_state,
+                                                 bool color, const int plies)
+    {
+        const vector<move_pos> saved_turns = turns; //     
+        const bool saved_beats = have_beats;
+        vector<vector<move_pos>> res(1);
+        Position pos = position;
+        for (int state = 0; state != -1 && first_move[state].x != -1; state = first_state[state])
+        {
+            res[0].push_back(first_move[state]);
+            pos.make_turn(first_move[state]);
+        }
+        color = !color;
+        while (int(res.size()) < plies)
+        {
+            tt_entry e;
+            if (!tt->probe(tt_key(pos, color), e) || e.best.x == -1)
+                break;
+            find_turns(color, pos);
+            if (find(turns.begin(), turns.end(), e.best) == turns.end())
+                break; //  
+            vector<move_pos> series(1, e.best);
+            pos.make_turn(e.best);
+            bool complete = true;
+            while (series.back().xb != -1)
+            {
+                find_turns(series.back().x2, series.back().y2, pos);
+                if (!have_beats)
+                    break;
+                if (turns.size() != 1)
+                {
+                    complete = false;
+                    break;
                 }
+                series.push_back(turns[0]);
+                pos.make_turn(turns[0]);
             }
+            if (!complete)
+                break;
+            res.push_back(move(series));
+            color = !color;
         }
-        else {
-            best_score = INF; //    
-            for (const auto& turn : turns) {
-                have_moves = true; //  
-                vector<vector<POS_T>> new_mtx = make_turn(mtx, turn); //      
-                double score = find_best_turns_rec(new_mtx, !color, depth - 1, alpha, beta, turn.x2, turn.y2); //     
+        turns = saved_turns;
+        have_beats = saved_beats;
+        return res;
+    }
 
-                best_score = std::min(best_score, score); //   
-                beta = std::min(beta, best_score); //  
+    //   ,        
+    bool time_over() const
+    {
+        if (node_limit && nodes >= node_limit)
+            return true;
+        if (!move_time_ms)
+            return false;
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start_time).count() >= move_time_ms;
+    }
 
-                if (beta <= alpha) { // --
-                    break; // ,     
-                }
+    //     : ,     
+    uint64_t tt_key(const Position &pos, const bool color) const
+    {
+        const Zobrist &z = zobrist();
+        return pos.key ^ (color ? z.side : 0) ^ (bot_color ? z.bot : 0);
+    }
+
+    //      :    ,   
+    //  , killer-  ,      
+    void order_turns(vector<move_pos> &turns_list, const Position &pos, const bool color, const size_t depth,
+                     const move_pos &tt_turn)
+    {
+        order_keys.resize(turns_list.size());
+        for (size_t i = 0; i < turns_list.size(); ++i)
+        {
+            const move_pos &turn = turns_list[i];
+            const int s = cell_index(turn.x, turn.y), s2 = cell_index(turn.x2, turn.y2);
+            int key;
+            if (turn == tt_turn)
+                key = 1 << 30;
+            else if (turn.xb != -1)
+                key = (1 << 29) + (pos.kings >> cell_index(turn.xb, turn.yb) & 1 ? 4 : 1);
+            else if (turn == killers[2 * depth])
+                key = (1 << 28) + 1;
+            else if (turn == killers[2 * depth + 1])
+                key = 1 << 28;
+            else
+                key = history[(color * 32 + s) * 32 + s2];
+            //         
+            if (!(pos.kings >> s & 1) && (color ? turn.x2 == 7 : turn.x2 == 0))
+                key += 8;
+            order_keys[i] = key;
+        }
+        //  :   
+        for (size_t i = 1; i < turns_list.size(); ++i)
+        {
+            const move_pos turn = turns_list[i];
+            const int key = order_keys[i];
+            size_t j = i;
+            for (; j > 0 && order_keys[j - 1] < key; --j)
+            {
+                turns_list[j] = turns_list[j - 1];
+                order_keys[j] = order_keys[j - 1];
             }
+            turns_list[j] = turn;
+            order_keys[j] = key;
         }
+    }
 
-        return best_score; //      
+    //     ,  : killer-      
+    void remember_cutoff(const move_pos &turn, const bool color, const size_t depth, const int rest)
+    {
+        if (turn != killers[2 * depth])
+        {
+            killers[2 * depth + 1] = killers[2 * depth];
+            killers[2 * depth] = turn;
+        }
+        int &h = history[(color * 32 + cell_index(turn.x, turn.y)) * 32 + cell_index(turn.x2, turn.y2)];
+        h = min(h + rest * rest, 1 << 27); // ,     killer-
+    }
+
+    //     ,     
+    static void put_first(vector<move_pos> &turns_list, const move_pos &turn)
+    {
+        auto it = find(turns_list.begin(), turns_list.end(), turn);
+        if (it != turns_list.end())
+            rotate(turns_list.begin(), it, it + 1);
     }
 
 
 public:
+    //     , nullptr  
+    void set_book(shared_ptr<const Opening_book> new_book)
+    {
+        book = new_book;
+    }
+
     //         ()
     void find_turns(const bool color)
     {
-        //    find_turns,      
-        find_turns(color, board->get_board());
+        //    find_turns,      
+        find_turns(color, position);
     }
 
     //         (x, y)
     void find_turns(const POS_T x, const POS_T y)
     {
-        //    find_turns       
-        find_turns(x, y, board->get_board());
+        //    find_turns      
+        find_turns(x, y, position);
     }
 
 
 private:
     //            
-    void find_turns(const bool color, const vector<vector<POS_T>>& mtx)
+    void find_turns(const bool color, const Position& pos)
     {
-        vector<move_pos> res_turns; //     
+        vector<move_pos> &res_turns = all_turns; //     ,  
+        res_turns.clear();
         bool have_beats_before = false; // , ,    
+        const Rays& r = rays();
 
-        //     
-        for (POS_T i = 0; i < 8; ++i)
+        //      
+        for (BB_T pieces = pos.pieces(color); pieces; pieces &= pieces - 1)
         {
-            for (POS_T j = 0; j < 8; ++j)
+            const int s = low_bit(pieces);
+            //      
+            find_turns(r.x[s], r.y[s], pos);
+            // ,   
+            if (have_beats && !have_beats_before)
             {
-                //          
-                if (mtx[i][j] && mtx[i][j] % 2 != color)
-                {
-                    //      
-                    find_turns(i, j, mtx);
-                    // ,   
-                    if (have_beats && !have_beats_before)
-                    {
-                        have_beats_before = true; //  ,   
-                        res_turns.clear(); //   ,    
-                    }
-                    //          
-                    if ((have_beats_before && have_beats) || !have_beats_before)
-                    {
-                        //      
-                        res_turns.insert(res_turns.end(), turns.begin(), turns.end());
-                    }
-                }
+                have_beats_before = true; //  ,   
+                res_turns.clear(); //   ,    
+            }
+            //          
+            if ((have_beats_before && have_beats) || !have_beats_before)
+            {
+                //      
+                res_turns.insert(res_turns.end(), turns.begin(), turns.end());
             }
         }
 
-        turns = res_turns; //   
-        shuffle(turns.begin(), turns.end(), rand_eng); //    
+        turns.swap(res_turns); //   
         have_beats = have_beats_before; //    
     }
 
 
     //         (x, y)
-    void find_turns(const POS_T x, const POS_T y, const vector<vector<POS_T>>& mtx)
+    void find_turns(const POS_T x, const POS_T y, const Position& pos)
     {
         turns.clear(); //    
         have_beats = false; //    
-        POS_T type = mtx[x][y]; //      
-
-        //   
-        switch (type)
+        const Rays& r = rays();
+        const int s = cell_index(x, y); //    
+        const BB_T bit = BB_T(1) << s;
+        if (!(pos.occupied() & bit))
+            return; //     
 
+        const bool color = (pos.black & bit) != 0; //  
+        const BB_T own = pos.pieces(color), enemy = pos.pieces(!color), occ = own | enemy;
+        const bool is_king = (pos.kings & bit) != 0;
 
+        //   
+        if (!is_king)
         {
-        case 1: //   
-        case 2: //   
-            //      
-            for (POS_T i = x - 2; i <= x + 2; i += 4) //   
+            //          
+            for (int d = 0; d < 4; ++d)
             {
-                for (POS_T j = y - 2; j <= y + 2; j += 4) //   
-                {
-                    //      
-                    if (i < 0 || i > 7 || j < 0 || j > 7)
-                        continue;
-
-                    //    
-                    POS_T xb = (x + i) / 2, yb = (y + j) / 2;
-                    // ,      
-                    if (mtx[i][j] || !mtx[xb][yb] || mtx[xb][yb] % 2 == type % 2)
-                        continue; // ,    
-
-                    //     
-                    turns.emplace_back(x, y, i, j, xb, yb);
-                }
+                if (r.len[s][d] < 2)
+                    continue; //      
+                const int sb = r.ray[s][d][0], s2 = r.ray[s][d][1];
+                // ,            
+                if (((occ >> s2) & 1) || !((enemy >> sb) & 1))
+                    continue; // ,    
+
+                //     
+                turns.emplace_back(x, y, r.x[s2], r.y[s2], r.x[sb], r.y[sb]);
             }
-
-            break;
-        default:
-            //     
-            for (POS_T i = -1; i <= 1; i += 2) //   
+        }
+        else
+        {
+            //     
+            for (int d = 0; d < 4; ++d)
             {
-                for (POS_T j = -1; j <= 1; j += 2)
+                int sb = -1; //   
+                //       
+                for (int k = 0; k < r.len[s][d]; ++k)
                 {
-                    POS_T xb = -1, yb = -1; //     
-                    //       
-                    for (POS_T i2 = x + i, j2 = y + j; i2 != 8 && j2 != 8 && i2 != -1 && j2 != -1; i2 += i, j2 += j)
+                    const int s2 = r.ray[s][d][k];
+                    if ((occ >> s2) & 1) //   
+                    {
+                        // ,          
+                        if (((own >> s2) & 1) || sb != -1)
+                            break;
+                        sb = s2; //     
+                        continue;
+                    }
+                    if (sb != -1) //     
                     {
-                        if (mtx[i2][j2]) //   
-                        {
-                            // ,    
-                            if (mtx[i2][j2] % 2 == type % 2 || (mtx[i2][j2] % 2 != type % 2 && xb != -1))
-                            {
-                                break; //             
-                            }
-                            xb = i2; //    
-                            yb = j2; //    
-                        }
-                        if (xb != -1 && xb != i2) //     
-                        {
-                            //     
-                            turns.emplace_back(x, y, i2, j2, xb, yb);
-                        }
+                        //     
+                        turns.emplace_back(x, y, r.x[s2], r.y[s2], r.x[sb], r.y[sb]);
                     }
                 }
             }
-            break;
         }
         //     
         if (!turns.empty()) //      
@@ -334,42 +941,36 @@ private:
         }
 
         //        
-        switch (type)
-        {
-        case 1: //   
-        case 2: //   
-            //      
+        if (!is_king)
         {
-            //       
-            POS_T i = ((type % 2) ? x - 1 : x + 1); //   x   
-            for (POS_T j = y - 1; j <= y + 1; j += 2) //     
+            //    ( 0  1),   ( 2  3)
+            const int d0 = color ? 2 : 0;
+            for (int d = d0; d < d0 + 2; ++d)
             {
                 //      
-                if (i < 0 || i > 7 || j < 0 || j > 7 || mtx[i][j])
+                if (!r.len[s][d] || ((occ >> r.ray[s][d][0]) & 1))
                     continue; // ,        
+                const int s2 = r.ray[s][d][0];
                 //     
-                turns.emplace_back(x, y, i, j); //     
+                turns.emplace_back(x, y, r.x[s2], r.y[s2]); //     
             }
-            break; //      
         }
-        default:
+        else
+        {
             //     
             //    ,  
-            for (POS_T i = -1; i <= 1; i += 2) //    (-  -)
+            for (int d = 0; d < 4; ++d)
             {
-                for (POS_T j = -1; j <= 1; j += 2) //    (-  -)
+                //       
+                for (int k = 0; k < r.len[s][d]; ++k)
                 {
-                    //       
-                    for (POS_T i2 = x + i, j2 = y + j; i2 != 8 && j2 != 8 && i2 != -1 && j2 != -1; i2 += i, j2 += j)
-                    {
-                        if (mtx[i2][j2]) //      
-                            break; //  ,     
-                        //        
-                        turns.emplace_back(x, y, i2, j2); //    
-                    }
+                    const int s2 = r.ray[s][d][k];
+                    if ((occ >> s2) & 1) //      
+                        break; //  ,     
+                    //        
+                    turns.emplace_back(x, y, r.x[s2], r.y[s2]); //    
                 }
             }
-            break; //      
         }
     }
 
@@ -377,13 +978,38 @@ private:
       vector<move_pos> turns; //     
       bool have_beats; // , ,   
       int Max_depth; //     
+      size_t nodes = 0; //  ,    
+      int last_depth = 0; //     
 
   private:
       default_random_engine rand_eng; //   
-      string scoring_mode; //    
-      string optimization; //  
+      root_search_fn root_search = nullptr; //         
+      Eval_weights weights; //   "Weighted"
       vector<move_pos> next_move; //     
       vector<int> next_best_state; //      
-      Board* board; //    
+      Position position; //  ,   set_position
+      shared_ptr<Trans_table> tt; //  ,        
+      shared_ptr<const Tablebase> tablebase; //  , nullptr -  
+      shared_ptr<const Opening_book> book; //  , nullptr -  
+      shared_ptr<const Nnue_network> nnue; //   , nullptr -  
+      vector<Nnue_accumulator> acc_stack; //        
+      bool bot_color = false; // ,     
+      int move_time_ms = 0; //     , 0 -  
+      size_t node_limit = 0; //     , 0 -  
+      chrono::steady_clock::time_point start_time; //   
+      bool stop = false; //     
+      bool can_stop = false; //     (  )
+      int threads_num = 1; //   
+      const atomic<bool> *external_stop = nullptr; //      
+      function<void(const search_info &)> on_iteration; //     
+      move_pos pv_turn = move_pos(-1, -1, -1, -1); //    
+      vector<move_pos> killers; //  killer-    
+      vector<int> history = vector<int>(2 * 32 * 32, 0); //  : ,  ,  
+      vector<int> order_keys; //   ,  
+      vector<undo_info> undo_stack; //       ,   
+      deque<vector<move_pos>> turn_stack; //     
+      vector<move_pos> all_turns; //      
+      Leaf_batch leaf_batch; //      
+      double leaf_scores[LEAF_BATCH_MAX]; //   
       Config* config; //    
 };
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+#include <stddef.h>
+#include <string>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX // min  max  windows.h  std::min  std::max
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ,      .     ,
+//       ,        
+class Mapped_file
+{
+  public:
+    Mapped_file() = default;
+    Mapped_file(const Mapped_file &) = delete;
+    Mapped_file &operator=(const Mapped_file &) = delete;
+    ~Mapped_file()
+    {
+        close();
+    }
+
+    //      ,  false,      
+    bool open(const std::string &path)
+    {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+        {
+            close();
+            return false;
+        }
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            close();
+            return false;
+        }
+        ptr = static_cast<const unsigned char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!ptr)
+        {
+            close();
+            return false;
+        }
+        len = size_t(file_size.QuadPart);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        void *addr = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); //       
+        if (addr == MAP_FAILED)
+            return false;
+        ptr = static_cast<const unsigned char *>(addr);
+        len = size_t(st.st_size);
+#endif
+        return true;
+    }
+
+    //    
+    void close()
+    {
+#ifdef _WIN32
+        if (ptr)
+            UnmapViewOfFile(ptr);
+        if (mapping)
+            CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (ptr)
+            munmap(const_cast<unsigned char *>(ptr), len);
+#endif
+        ptr = nullptr;
+        len = 0;
+    }
+
+    //    ,     :   
+    //    .    
+    void advise_sequential() const
+    {
+#ifndef _WIN32
+        if (ptr)
+            madvise(const_cast<unsigned char *>(ptr), len, MADV_SEQUENTIAL);
+#endif
+    }
+
+    const unsigned char *data() const
+    {
+        return ptr;
+    }
+
+    size_t size() const
+    {
+        return len;
+    }
+
+    bool is_open() const
+    {
+        return ptr != nullptr;
+    }
+
+  private:
+    const unsigned char *ptr = nullptr; //   
+    size_t len = 0;                     //    
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
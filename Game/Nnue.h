@@ -0,0 +1,220 @@
+#pragma once
+#include <algorithm>
+#include <fstream>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+#include "../Models/Position.h"
+#include "Simd.h"
+
+//     NNUE: 128  (  x ) -> 64    -> 1 .
+//     -        ().   -
+// ,      ,     
+// .  :  int16,    [0, NNUE_QA],  
+//   int16    int32.        (Simd.h).
+//   Tools/nnuetrain.cpp,   -     .
+//
+//  :  nnue_header,  int16 ft_bias[NNUE_HIDDEN], int16 ft_weights[NNUE_INPUTS][NNUE_HIDDEN],
+// int8 out_weights[NNUE_HIDDEN], int32 out_bias.     little-endian.
+
+const int NNUE_INPUTS = 4 * 32; //    type (1..4   )   s: (type - 1) * 32 + s
+const int NNUE_HIDDEN = 64;     //    
+const int NNUE_QA = 127;        //    :  1.0  NNUE_QA
+const int NNUE_QB = 64;         //    
+
+//   
+struct nnue_header
+{
+    char magic[4];    // "CKNN"
+    uint32_t version; //  
+    uint32_t inputs;  //  ,   NNUE_INPUTS
+    uint32_t hidden;  //    ,   NNUE_HIDDEN
+};
+
+const uint32_t NNUE_VERSION = 1;
+
+//      type   s
+inline int nnue_feature(const POS_T type, const int s)
+{
+    return (type - 1) * 32 + s;
+}
+
+//        
+struct Nnue_accumulator
+{
+    alignas(32) int16_t v[NNUE_HIDDEN];
+};
+
+// dst = src + add - sub - sub2,  add, sub, sub2 -  , sub2 = nullptr -   
+inline void nnue_update_scalar(const int16_t *src, int16_t *dst, const int16_t *add, const int16_t *sub,
+                               const int16_t *sub2)
+{
+    for (int i = 0; i < NNUE_HIDDEN; ++i)
+        dst[i] = int16_t(src[i] + add[i] - sub[i] - (sub2 ? sub2[i] : 0));
+}
+
+//  clamp(acc, 0, NNUE_QA) * w    
+inline int32_t nnue_dot_scalar(const int16_t *acc, const int16_t *w)
+{
+    int32_t sum = 0;
+    for (int i = 0; i < NNUE_HIDDEN; ++i)
+        sum += int32_t(std::min<int16_t>(std::max<int16_t>(acc[i], 0), NNUE_QA)) * w[i];
+    return sum;
+}
+
+#ifdef SIMD_X86
+SIMD_TARGET("avx2")
+inline void nnue_update_avx2(const int16_t *src, int16_t *dst, const int16_t *add, const int16_t *sub,
+                             const int16_t *sub2)
+{
+    for (int i = 0; i < NNUE_HIDDEN; i += 16)
+    {
+        __m256i v = _mm256_add_epi16(_mm256_loadu_si256((const __m256i *)(src + i)),
+                                     _mm256_loadu_si256((const __m256i *)(add + i)));
+        v = _mm256_sub_epi16(v, _mm256_loadu_si256((const __m256i *)(sub + i)));
+        if (sub2)
+            v = _mm256_sub_epi16(v, _mm256_loadu_si256((const __m256i *)(sub2 + i)));
+        _mm256_storeu_si256((__m256i *)(dst + i), v);
+    }
+}
+
+SIMD_TARGET("avx2")
+inline int32_t nnue_dot_avx2(const int16_t *acc, const int16_t *w)
+{
+    const __m256i zero = _mm256_setzero_si256(), qa = _mm256_set1_epi16(NNUE_QA);
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < NNUE_HIDDEN; i += 16)
+    {
+        const __m256i a =
+            _mm256_min_epi16(_mm256_max_epi16(_mm256_loadu_si256((const __m256i *)(acc + i)), zero), qa);
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a, _mm256_loadu_si256((const __m256i *)(w + i))));
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    return _mm_cvtsi128_si32(s);
+}
+
+SIMD_TARGET("sse4.1")
+inline void nnue_update_sse41(const int16_t *src, int16_t *dst, const int16_t *add, const int16_t *sub,
+                              const int16_t *sub2)
+{
+    for (int i = 0; i < NNUE_HIDDEN; i += 8)
+    {
+        __m128i v = _mm_add_epi16(_mm_loadu_si128((const __m128i *)(src + i)),
+                                  _mm_loadu_si128((const __m128i *)(add + i)));
+        v = _mm_sub_epi16(v, _mm_loadu_si128((const __m128i *)(sub + i)));
+        if (sub2)
+            v = _mm_sub_epi16(v, _mm_loadu_si128((const __m128i *)(sub2 + i)));
+        _mm_storeu_si128((__m128i *)(dst + i), v);
+    }
+}
+
+SIMD_TARGET("sse4.1")
+inline int32_t nnue_dot_sse41(const int16_t *acc, const int16_t *w)
+{
+    const __m128i zero = _mm_setzero_si128(), qa = _mm_set1_epi16(NNUE_QA);
+    __m128i sum = _mm_setzero_si128();
+    for (int i = 0; i < NNUE_HIDDEN; i += 8)
+    {
+        const __m128i a = _mm_min_epi16(_mm_max_epi16(_mm_loadu_si128((const __m128i *)(acc + i)), zero), qa);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(a, _mm_loadu_si128((const __m128i *)(w + i))));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+}
+#endif
+
+// ,   
+class Nnue_network
+{
+  public:
+    //      ,  false,      
+    bool load(const std::string &path)
+    {
+        std::ifstream fin(path, std::ios::binary);
+        if (!fin)
+            return false;
+        nnue_header header;
+        int8_t out8[NNUE_HIDDEN];
+        fin.read(reinterpret_cast<char *>(&header), sizeof(header));
+        if (!fin || memcmp(header.magic, "CKNN", 4) || header.version != NNUE_VERSION ||
+            header.inputs != uint32_t(NNUE_INPUTS) || header.hidden != uint32_t(NNUE_HIDDEN))
+            return false;
+        fin.read(reinterpret_cast<char *>(ft_bias.v), sizeof(ft_bias.v));
+        fin.read(reinterpret_cast<char *>(ft_weights), sizeof(ft_weights));
+        fin.read(reinterpret_cast<char *>(out8), sizeof(out8));
+        fin.read(reinterpret_cast<char *>(&out_bias), sizeof(out_bias));
+        if (!fin)
+            return false;
+        //     int8    int16    
+        for (int i = 0; i < NNUE_HIDDEN; ++i)
+            out_weights.v[i] = out8[i];
+        return true;
+    }
+
+    //         
+    void refresh(const Position &pos, Nnue_accumulator &acc) const
+    {
+        acc = ft_bias;
+        for (BB_T b = pos.occupied(); b; b &= b - 1)
+        {
+            const int s = low_bit(b);
+            const int16_t *w = ft_weights[nnue_feature(pos.get(s), s)];
+            for (int i = 0; i < NNUE_HIDDEN; ++i)
+                acc.v[i] += w[i];
+        }
+    }
+
+    //      :  add , sub  sub2  (sub2 = -1 - )
+    void update(const Nnue_accumulator &from, Nnue_accumulator &to, const int add, const int sub,
+                const int sub2) const
+    {
+        const int16_t *w2 = sub2 >= 0 ? ft_weights[sub2] : nullptr;
+#ifdef SIMD_X86
+        switch (simd_level())
+        {
+        case Simd_level::AVX2:
+            nnue_update_avx2(from.v, to.v, ft_weights[add], ft_weights[sub], w2);
+            return;
+        case Simd_level::SSE41:
+            nnue_update_sse41(from.v, to.v, ft_weights[add], ft_weights[sub], w2);
+            return;
+        default:
+            break;
+        }
+#endif
+        nnue_update_scalar(from.v, to.v, ft_weights[add], ft_weights[sub], w2);
+    }
+
+    //  :     
+    double logit(const Nnue_accumulator &acc) const
+    {
+        int32_t sum;
+#ifdef SIMD_X86
+        switch (simd_level())
+        {
+        case Simd_level::AVX2:
+            sum = nnue_dot_avx2(acc.v, out_weights.v);
+            break;
+        case Simd_level::SSE41:
+            sum = nnue_dot_sse41(acc.v, out_weights.v);
+            break;
+        default:
+            sum = nnue_dot_scalar(acc.v, out_weights.v);
+            break;
+        }
+#else
+        sum = nnue_dot_scalar(acc.v, out_weights.v);
+#endif
+        return double(sum + out_bias) / (NNUE_QA * NNUE_QB);
+    }
+
+  private:
+    Nnue_accumulator ft_bias;                                //   
+    alignas(32) int16_t ft_weights[NNUE_INPUTS][NNUE_HIDDEN]; //      
+    Nnue_accumulator out_weights;                            //   
+    int32_t out_bias = 0;                                    //     NNUE_QA * NNUE_QB
+};
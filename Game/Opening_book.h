@@ -0,0 +1,90 @@
+#pragma once
+#include <algorithm>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+#include "../Models/Position.h"
+#include "Mapped_file.h"
+
+//  :      ,      ,
+//     .   Tools/bookgen.cpp,     
+//           ,   .
+//
+//  :  book_header,  count  book_entry,    .
+//     .
+
+const int BOOK_PATH_LEN = 8; //      :    7  
+const uint8_t BOOK_NO_CELL = 0xFF;
+
+//   
+struct book_header
+{
+    char magic[4];    // "CKBK"
+    uint32_t version; //  
+    uint64_t count;   //  
+};
+
+const uint32_t BOOK_VERSION = 1;
+
+//    :    
+inline uint64_t book_key(const Position &pos, const bool color)
+{
+    return pos.key ^ (color ? zobrist().side : 0);
+}
+
+//    
+struct book_entry
+{
+    uint64_t key;                //      
+    uint8_t path[BOOK_PATH_LEN]; //  :       , BOOK_NO_CELL - 
+    uint32_t games;              //     
+    uint32_t points;             //      : 2  , 1  
+};
+
+//  ,      
+class Opening_book
+{
+  public:
+    //     ,  false,      
+    bool open(const std::string &path)
+    {
+        entries = nullptr;
+        count = 0;
+        if (!file.open(path) || file.size() < sizeof(book_header))
+            return false;
+        book_header header;
+        memcpy(&header, file.data(), sizeof(header));
+        if (memcmp(header.magic, "CKBK", 4) || header.version != BOOK_VERSION ||
+            header.count > (file.size() - sizeof(book_header)) / sizeof(book_entry))
+        {
+            file.close();
+            return false;
+        }
+        entries = reinterpret_cast<const book_entry *>(file.data() + sizeof(book_header));
+        count = size_t(header.count);
+        return true;
+    }
+
+    //        key:      
+    std::pair<const book_entry *, const book_entry *> probe(const uint64_t key) const
+    {
+        const book_entry *end = entries + count;
+        const book_entry *first =
+            std::lower_bound(entries, end, key, [](const book_entry &e, const uint64_t k) { return e.key < k; });
+        const book_entry *last = first;
+        while (last != end && last->key == key)
+            ++last;
+        return {first, last};
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+  private:
+    Mapped_file file;
+    const book_entry *entries = nullptr; //    
+    size_t count = 0;
+};
@@ -0,0 +1,490 @@
+#pragma once
+#include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Models/Move.h"
+#include "../Models/Move_history.h"
+#include "../Models/Position.h"
+#include "Logic.h"
+#include "Mapped_file.h"
+
+//     PDN (Portable Draughts Notation):  [ ""],    
+//  : "1. 22-18 11-15 2. 18x11 8x15 1-0".   1..32,   FEN (Models/Position.h):
+// 1..4 -     ,   .     
+//  (c3-d4, a1 -   ),  {...},  (...), NAG ($1)   !?.
+//   -  : "15x22x31"      "15x31"     .
+// : 1-0 ( ), 0-1, 1/2-1/2, * (  ),  2-0, 0-2, 1-1
+
+//   :   (0..31)   
+struct pdn_move
+{
+    vector<int> squares;
+    bool capture = false;
+};
+
+//   
+struct pdn_game
+{
+    vector<pair<string, string>> tags;
+    vector<pdn_move> moves;
+    string result = "*";
+    string error; //   ,   -  
+
+    //   name,   -  
+    string tag(const string &name) const
+    {
+        for (const auto &t : tags)
+            if (t.first == name)
+                return t.second;
+        return "";
+    }
+};
+
+//    : 1 - , 0.5 - , 0 - , -1 - 
+inline double pdn_white_score(const string &result)
+{
+    if (result == "1-0" || result == "2-0")
+        return 1;
+    if (result == "0-1" || result == "0-2")
+        return 0;
+    if (result == "1/2-1/2" || result == "1-1")
+        return 0.5;
+    return -1;
+}
+
+//    (  )   : "22-18", "15x22x31"
+inline string pdn_move_text(const vector<move_pos> &turns)
+{
+    string res = to_string(cell_index(turns[0].x, turns[0].y) + 1);
+    for (const auto &turn : turns)
+        res += (turn.xb == -1 ? "-" : "x") + to_string(cell_index(turn.x2, turn.y2) + 1);
+    return res;
+}
+
+//      .         .
+//       ,     FEN
+inline string pdn_write(const Move_history &history, vector<pair<string, string>> tags, const string &result)
+{
+    const Position start = history.position_at(0), initial = Position::start();
+    if (start.white != initial.white || start.black != initial.black || start.kings != initial.kings)
+        tags.emplace_back("FEN", start.to_fen(false));
+    tags.emplace_back("Result", result);
+    string res;
+    for (const auto &t : tags)
+    {
+        string value;
+        for (const char c : t.second)
+        {
+            if (c == '"' || c == '\\')
+                value += '\\';
+            value += c;
+        }
+        res += "[" + t.first + " \"" + value + "\"]\n";
+    }
+    res += '\n';
+
+    string line;
+    auto add_token = [&](const string &token) {
+        if (!line.empty() && line.size() + 1 + token.size() > 80)
+        {
+            res += line + '\n';
+            line.clear();
+        }
+        line += (line.empty() ? "" : " ") + token;
+    };
+    int ply = 0;
+    for (size_t i = 0; i < history.size(); ++ply)
+    {
+        const history_entry &first = history[i];
+        string move = to_string(first.from + 1);
+        for (++i, move += (first.series ? "x" : "-") + to_string(first.to + 1);
+             i < history.size() && history[i].series > 1; ++i)
+            move += "x" + to_string(history[i].to + 1); //   
+        if (ply % 2 == 0)
+            move = to_string(ply / 2 + 1) + ". " + move;
+        add_token(move);
+    }
+    add_token(result);
+    return res + line + "\n\n";
+}
+
+//    PDN:         , 
+//           
+class Pdn_reader
+{
+  public:
+    //    ,  false,    
+    bool open(const string &path)
+    {
+        if (!file.open(path))
+            return false;
+        file.advise_sequential();
+        set_data(reinterpret_cast<const char *>(file.data()), file.size());
+        return true;
+    }
+
+    //      ,   .     
+    void set_data(const char *data, const size_t size)
+    {
+        begin = p = data;
+        end = data + size;
+        if (size >= 3 && data[0] == '\xEF' && data[1] == '\xBB' && data[2] == '\xBF')
+            p += 3; //    UTF-8
+    }
+
+    //  
+    size_t offset() const
+    {
+        return size_t(p - begin);
+    }
+
+    //     ,  false   .   
+    // ,  game.error - ,      
+    bool next(pdn_game &game)
+    {
+        game.tags.clear();
+        game.moves.clear();
+        game.result = "*";
+        game.error.clear();
+        skip_spaces();
+        if (p >= end)
+            return false;
+        // 
+        while (p < end && *p == '[')
+        {
+            if (!read_tag(game))
+                return fail(game, "bad tag");
+            skip_spaces();
+        }
+        //        
+        while (p < end)
+        {
+            skip_spaces();
+            if (p >= end || *p == '[')
+                break;
+            if (*p == '{' || *p == '(')
+            {
+                if (!skip_group())
+                    return fail(game, "unclosed comment");
+                continue;
+            }
+            if (*p == ';')
+            {
+                skip_line();
+                continue;
+            }
+            const char *token = p;
+            while (p < end && !is_space(*p) && *p != '{' && *p != '(' && *p != '[' && *p != ';')
+                ++p;
+            const string text(token, p);
+            if (text == "1-0" || text == "0-1" || text == "1/2-1/2" || text == "2-0" || text == "0-2" ||
+                text == "1-1" || text == "0-0" || text == "*")
+            {
+                game.result = text;
+                break;
+            }
+            if (!read_token(text, game))
+                return fail(game, "bad move '" + text + "'");
+        }
+        if (game.tag("Result").size() && game.result == "*")
+            game.result = game.tag("Result");
+        return true;
+    }
+
+    //       i   text: "22-18", "15x22x31", "c3-d4",   !?.
+    //  false,   
+    static bool parse_move(const string &text, size_t i, pdn_move &m)
+    {
+        m.squares.clear();
+        m.capture = false;
+        while (true)
+        {
+            const int s = parse_square(text, i);
+            if (s < 0)
+                return false;
+            m.squares.push_back(s);
+            if (i < text.size() && (text[i] == '-' || text[i] == 'x' || text[i] == ':'))
+            {
+                m.capture |= text[i] != '-';
+                ++i;
+                continue;
+            }
+            break;
+        }
+        //     
+        while (i < text.size() && (text[i] == '!' || text[i] == '?' || text[i] == '*' || text[i] == '+'))
+            ++i;
+        return i == text.size() && m.squares.size() >= 2;
+    }
+
+  private:
+    static bool is_space(const char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    void skip_spaces()
+    {
+        while (p < end && is_space(*p))
+            ++p;
+    }
+
+    void skip_line()
+    {
+        while (p < end && *p != '\n')
+            ++p;
+    }
+
+    //   {...}   (...),    
+    bool skip_group()
+    {
+        if (*p == '{')
+        {
+            while (p < end && *p != '}')
+                ++p;
+            if (p >= end)
+                return false;
+            ++p;
+            return true;
+        }
+        int depth = 0;
+        for (; p < end; ++p)
+        {
+            if (*p == '{')
+            {
+                if (!skip_group())
+                    return false;
+                --p;
+            }
+            else if (*p == '(')
+                ++depth;
+            else if (*p == ')' && --depth == 0)
+            {
+                ++p;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //  [ ""],   \"  \\ -  
+    bool read_tag(pdn_game &game)
+    {
+        ++p;
+        const char *name = p;
+        while (p < end && !is_space(*p) && *p != ']' && *p != '"')
+            ++p;
+        string key(name, p), value;
+        skip_spaces();
+        if (p >= end || *p != '"')
+            return false;
+        for (++p; p < end && *p != '"'; ++p)
+        {
+            if (*p == '\\' && p + 1 < end)
+                ++p;
+            value += *p;
+        }
+        while (p < end && *p != ']' && *p != '\n')
+            ++p;
+        if (p >= end || *p != ']')
+            return false;
+        ++p;
+        game.tags.emplace_back(move(key), move(value));
+        return true;
+    }
+
+    //   0..31   "1".."32"  "a1".."h8", -1 -  
+    static int parse_square(const string &text, size_t &i)
+    {
+        if (i < text.size() && text[i] >= 'a' && text[i] <= 'h')
+        {
+            if (i + 1 >= text.size() || text[i + 1] < '1' || text[i + 1] > '8')
+                return -1;
+            const int x = '8' - text[i + 1], y = text[i] - 'a';
+            i += 2;
+            return (x + y) % 2 ? cell_index(POS_T(x), POS_T(y)) : -1;
+        }
+        int num = 0, digits = 0;
+        for (; i < text.size() && text[i] >= '0' && text[i] <= '9' && digits < 3; ++i, ++digits)
+            num = num * 10 + (text[i] - '0');
+        return digits && num >= 1 && num <= 32 ? num - 1 : -1;
+    }
+
+    //     :  , NAG,        ("1.22-18")
+    bool read_token(const string &text, pdn_game &game)
+    {
+        size_t i = 0;
+        if (text[0] == '$')
+            return true; // NAG
+        //  :      
+        size_t j = 0;
+        while (j < text.size() && text[j] >= '0' && text[j] <= '9')
+            ++j;
+        if (j && j < text.size() && text[j] == '.')
+        {
+            while (j < text.size() && text[j] == '.')
+                ++j;
+            if (j == text.size())
+                return true;
+            i = j;
+        }
+        pdn_move m;
+        if (!parse_move(text, i, m))
+            return false;
+        game.moves.push_back(move(m));
+        return true;
+    }
+
+    //   :       
+    bool fail(pdn_game &game, const string &error)
+    {
+        game.error = error;
+        while (p < end)
+        {
+            skip_line();
+            if (p < end)
+                ++p;
+            if (p < end && *p == '[')
+                break;
+        }
+        return true;
+    }
+
+    Mapped_file file;
+    const char *begin = nullptr, *p = nullptr, *end = nullptr;
+};
+
+//    :        .
+//  positions        .  false  
+//  error,   
+class Pdn_replay
+{
+  public:
+    explicit Pdn_replay(Logic &logic) : logic(logic)
+    {
+    }
+
+    bool replay(const pdn_game &game, vector<pair<Position, bool>> *positions, string &error)
+    {
+        pos = Position::start();
+        color = false;
+        const string fen = game.tag("FEN");
+        if (!fen.empty() && !Position::from_fen(fen, pos, color))
+        {
+            error = "bad FEN";
+            return false;
+        }
+        for (size_t i = 0; i < game.moves.size(); ++i)
+        {
+            if (positions)
+                positions->emplace_back(pos, color);
+            //       :   ,    ..
+            const pdn_move &m = game.moves[i];
+            const size_t min_steps = m.squares.size() > 2 ? m.squares.size() - 1 : 1;
+            const size_t max_steps = m.squares.size() > 2 ? m.squares.size() - 1 : MAX_SERIES;
+            bool found = false;
+            for (size_t steps = min_steps; !found && steps <= min(max_steps, MAX_SERIES); ++steps)
+            {
+                path.clear();
+                found = match(pos, color, m, 0, steps);
+            }
+            if (!found)
+            {
+                error = "illegal move " + to_string(i / 2 + 1) + (i % 2 ? "..." : ".") + " " + text(game.moves[i]);
+                return false;
+            }
+            for (const auto &turn : path)
+                pos.make_turn(turn);
+            color = !color;
+        }
+        return true;
+    }
+
+    //    ,   -  
+    const vector<move_pos> &last_turns() const
+    {
+        return path;
+    }
+
+    //          
+    const Position &position() const
+    {
+        return pos;
+    }
+
+    bool turn_color() const
+    {
+        return color;
+    }
+
+  private:
+    static constexpr size_t MAX_SERIES = 12; //      :   12 
+
+    static string text(const pdn_move &m)
+    {
+        string res;
+        for (size_t i = 0; i < m.squares.size(); ++i)
+            res += (i ? (m.capture ? "x" : "-") : "") + to_string(m.squares[i] + 1);
+        return res;
+    }
+
+    //      pos,    m,    step,   steps .
+    //         ,     
+    bool match(const Position &pos, const bool color, const pdn_move &m, const size_t step, const size_t steps)
+    {
+        logic.set_position(pos);
+        if (step == 0)
+            logic.find_turns(color);
+        else
+        {
+            logic.find_turns(path.back().x2, path.back().y2);
+            if (!logic.have_beats) //   : ,      
+                return step == steps && cell_index(path.back().x2, path.back().y2) == m.squares.back();
+            if (step == steps)
+                return false;
+        }
+        const bool full_path = m.squares.size() > 2;
+        vector<move_pos> &turns = candidates[step]; //    
+        turns = logic.turns;
+        for (const auto &turn : turns)
+        {
+            if (step == 0 && cell_index(turn.x, turn.y) != m.squares[0])
+                continue;
+            const int to = cell_index(turn.x2, turn.y2);
+            if (full_path && to != m.squares[step + 1])
+                continue;
+            path.push_back(turn);
+            if (turn.xb == -1)
+            {
+                if (to == m.squares.back() && steps == 1)
+                    return true; //  
+            }
+            else
+            {
+                Position next = pos;
+                next.make_turn(turn);
+                if (match(next, color, m, step + 1, steps))
+                    return true;
+            }
+            path.pop_back();
+        }
+        return false;
+    }
+
+    Logic &logic;
+    Position pos;          //   
+    bool color = false;    //    
+    vector<move_pos> path; //   
+    vector<vector<move_pos>> candidates = vector<vector<move_pos>>(MAX_SERIES + 1); //     
+};
+
+//      Date: "2024.05.17"
+inline string pdn_date()
+{
+    const time_t now = time(nullptr);
+    char buf[16];
+    strftime(buf, sizeof(buf), "%Y.%m.%d", localtime(&now));
+    return buf;
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include <atomic>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../Models/Move.h"
+#include "../Models/Position.h"
+#include "Logic.h"
+
+//    :    ,      
+//            .   , 
+//      ,  .     Logic   
+// ,      .      
+// ,   ,  
+class Ponder
+{
+  public:
+    ~Ponder()
+    {
+        stop();
+    }
+
+    //    :       logic,
+    // color -  ,   , depth -  
+    void start(const Logic &logic, const bool color, const int depth)
+    {
+        stop();
+        results.clear();
+        searcher = make_unique<Logic>(logic);
+        searcher->set_stop_flag(&stop_flag);
+        searcher->set_move_time(0); //      
+        searcher->set_progress(nullptr);
+        searcher->Max_depth = depth;
+        stop_flag = false;
+        searched = 0;
+
+        // ,  ,  
+        vector<vector<move_pos>> replies;
+        collect_replies(*searcher, color, {}, replies);
+        move_pos expected(-1, -1, -1, -1);
+        if (logic.expected_turn(color, expected))
+            stable_partition(replies.begin(), replies.end(),
+                             [&](const vector<move_pos> &r) { return r.front() == expected; });
+        const Position pos = logic.get_position();
+        replies_num = int(replies.size());
+        worker = thread(&Ponder::run, this, pos, color, depth, move(replies));
+    }
+
+    //    ,   
+    void stop()
+    {
+        stop_flag = true;
+        if (worker.joinable())
+            worker.join();
+    }
+
+    //   ,     ,    
+    int searched_num() const
+    {
+        return searched;
+    }
+
+    int total_num() const
+    {
+        return replies_num;
+    }
+
+    //        color   pos   depth.
+    //  false,        
+    bool take(const Position &pos, const bool color, const int depth, vector<move_pos> &res)
+    {
+        stop();
+        const auto it = results.find(book_key(pos, color));
+        if (it == results.end() || it->second.first != depth)
+            return false;
+        res = it->second.second;
+        return true;
+    }
+
+  private:
+    //       color   logic:   -  
+    static void collect_replies(Logic &logic, const bool color, vector<move_pos> prefix,
+                                vector<vector<move_pos>> &replies)
+    {
+        if (!prefix.empty() && prefix.back().xb == -1)
+        {
+            replies.push_back(prefix); //  
+            return;
+        }
+        const Position saved = logic.get_position();
+        if (prefix.empty())
+            logic.find_turns(color);
+        else
+            logic.find_turns(prefix.back().x2, prefix.back().y2);
+        if (!prefix.empty() && !logic.have_beats)
+        {
+            replies.push_back(prefix); //   
+            return;
+        }
+        const vector<move_pos> turns = logic.turns;
+        for (const auto &turn : turns)
+        {
+            logic.make_turn(turn);
+            prefix.push_back(turn);
+            collect_replies(logic, color, prefix, replies);
+            prefix.pop_back();
+            logic.set_position(saved);
+        }
+    }
+
+    //  :    ,     
+    void run(const Position pos, const bool color, const int depth, const vector<vector<move_pos>> replies)
+    {
+        for (const auto &reply : replies)
+        {
+            searcher->set_position(pos);
+            for (const auto &turn : reply)
+                searcher->make_turn(turn);
+            const Position after = searcher->get_position();
+            searcher->find_turns(!color);
+            if (searcher->turns.empty())
+            {
+                ++searched;
+                continue; //       -  
+            }
+            vector<move_pos> best = searcher->find_best_turns(!color);
+            if (searcher->last_depth == depth)
+            {
+                results[book_key(after, !color)] = {depth, move(best)};
+                ++searched;
+            }
+            if (stop_flag)
+                break; //   ,    
+        }
+    }
+
+    unique_ptr<Logic> searcher; //     
+    thread worker; //  
+    atomic<bool> stop_flag{false};
+    atomic<int> searched{0}; //    
+    int replies_num = 0; //     
+    //       :   .     
+    map<uint64_t, pair<int, vector<move_pos>>> results;
+};
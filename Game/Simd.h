@@ -0,0 +1,67 @@
+#pragma once
+
+//          Nnue.h.
+//   AVX2  SSE4.1    target,     
+// -mavx2     :    ,   -  
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#ifdef SIMD_X86
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SIMD_TARGET(isa)
+#endif
+#endif
+
+//   ,  
+enum class Simd_level
+{
+    SCALAR,
+    SSE41,
+    AVX2
+};
+
+inline Simd_level detect_simd()
+{
+#ifdef SIMD_X86
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    __cpuid(info, 1);
+    const bool sse41 = info[2] & (1 << 19);
+    // AVX2     YMM  
+    const bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+    bool avx2 = false;
+    if (max_leaf >= 7 && os_avx)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = info[1] & (1 << 5);
+    }
+    if (avx2)
+        return Simd_level::AVX2;
+    if (sse41)
+        return Simd_level::SSE41;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return Simd_level::AVX2;
+    if (__builtin_cpu_supports("sse4.1"))
+        return Simd_level::SSE41;
+#endif
+#endif
+    return Simd_level::SCALAR;
+}
+
+inline Simd_level simd_level()
+{
+    static const Simd_level level = detect_simd();
+    return level;
+}
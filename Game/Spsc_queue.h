@@ -0,0 +1,36 @@
+#pragma once
+#include <atomic>
+#include <stddef.h>
+
+//         :      
+//     .  ,      
+template <class T, size_t N> class Spsc_queue
+{
+  public:
+    //    ,   .  false,   
+    bool push(const T &item)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == N)
+            return false;
+        items[tail % N] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    //    ,   .  false,   
+    bool pop(T &item)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return false;
+        item = items[head % N];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    T items[N];
+    std::atomic<size_t> head_{0}; //     
+    std::atomic<size_t> tail_{0}; //     
+};
@@ -0,0 +1,297 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+#include "../Models/Position.h"
+#include "Mapped_file.h"
+
+//  :            
+// (,   )      .    
+// .   Tools/tbgen.cpp,        .
+//
+//  :  tb_header,  tables  tb_table_info,   .
+//  -    (     ),    .
+//   :     ( ,  ,  ,
+//  ),   -       , 
+//     .    -  .
+
+const int TB_MAX_PIECES = 6; //   ,    
+
+//   
+struct tb_header
+{
+    char magic[4];       // "CKTB"
+    uint32_t version;    //  
+    uint32_t max_pieces; //      
+    uint32_t tables;     //  
+};
+
+const uint32_t TB_VERSION = 1;
+
+//     
+struct tb_table_info
+{
+    uint8_t men[2];   //     
+    uint8_t kings[2]; //     
+    uint32_t reserved;
+    uint64_t offset; //      
+    uint64_t count;  //   ()  
+};
+
+//    ,  
+enum class tb_outcome : uint8_t
+{
+    DRAW,
+    WIN,
+    LOSS
+};
+
+//    : 0 - ,       + 1.
+// ׸   -   ,  - 
+inline uint8_t tb_encode(const tb_outcome outcome, int plies)
+{
+    if (outcome == tb_outcome::DRAW)
+        return 0;
+    if (plies > 253)
+        plies = 252 + plies % 2; //       
+    return uint8_t(plies + 1);
+}
+
+inline tb_outcome tb_decode(const uint8_t value, int &plies)
+{
+    if (value == 0)
+    {
+        plies = 0;
+        return tb_outcome::DRAW;
+    }
+    plies = value - 1;
+    return plies % 2 ? tb_outcome::WIN : tb_outcome::LOSS;
+}
+
+//  :      ,  0 - 
+struct tb_material
+{
+    int men[2] = {0, 0};
+    int kings[2] = {0, 0};
+
+    tb_material() = default;
+    explicit tb_material(const Position &pos)
+    {
+        for (int c = 0; c < 2; ++c)
+        {
+            men[c] = pos.men_count[c];
+            kings[c] = pos.king_count[c];
+        }
+    }
+
+    int pieces() const
+    {
+        return men[0] + men[1] + kings[0] + kings[1];
+    }
+
+    bool operator==(const tb_material &other) const
+    {
+        return !memcmp(men, other.men, sizeof(men)) && !memcmp(kings, other.kings, sizeof(kings));
+    }
+
+    //     :  ,  ,  ,  
+    int group(const int g) const
+    {
+        return g % 2 ? kings[g / 2] : men[g / 2];
+    }
+};
+
+//      
+struct Binomials
+{
+    uint64_t c[33][33];
+
+    Binomials()
+    {
+        for (int n = 0; n <= 32; ++n)
+        {
+            c[n][0] = 1;
+            for (int k = 1; k <= 32; ++k)
+                c[n][k] = n ? c[n - 1][k - 1] + c[n - 1][k] : 0;
+        }
+    }
+};
+
+inline const Binomials &binomials()
+{
+    static const Binomials b;
+    return b;
+}
+
+//        
+inline uint64_t tb_size(const tb_material &m)
+{
+    const Binomials &b = binomials();
+    uint64_t res = 2;
+    int free = 32;
+    for (int g = 0; g < 4; ++g)
+    {
+        res *= b.c[free][m.group(g)];
+        free -= m.group(g);
+    }
+    return res;
+}
+
+//     
+inline void tb_groups(const Position &pos, BB_T groups[4])
+{
+    groups[0] = pos.white & ~pos.kings;
+    groups[1] = pos.white & pos.kings;
+    groups[2] = pos.black & ~pos.kings;
+    groups[3] = pos.black & pos.kings;
+}
+
+//       , color -  
+inline uint64_t tb_index(const Position &pos, const bool color)
+{
+    const Binomials &b = binomials();
+    BB_T groups[4];
+    tb_groups(pos, groups);
+    BB_T used = 0;
+    uint64_t idx = 0;
+    for (int g = 0; g < 4; ++g)
+    {
+        const int free = 32 - pop_count(used), k = pop_count(groups[g]);
+        uint64_t rank = 0;
+        int i = 0;
+        for (BB_T bits = groups[g]; bits; bits &= bits - 1, ++i)
+        {
+            const int s = low_bit(bits);
+            //       
+            const int cell = s - pop_count(used & ((BB_T(1) << s) - 1));
+            rank += b.c[cell][i + 1];
+        }
+        idx = idx * b.c[free][k] + rank;
+        used |= groups[g];
+    }
+    return idx * 2 + color;
+}
+
+//         m,   tb_index
+inline Position tb_position(const tb_material &m, uint64_t idx, bool &color)
+{
+    const Binomials &b = binomials();
+    color = idx & 1;
+    idx >>= 1;
+    uint64_t ranks[4];
+    int free_before[4];
+    int free = 32;
+    for (int g = 0; g < 4; ++g)
+    {
+        free_before[g] = free;
+        free -= m.group(g);
+    }
+    for (int g = 3; g >= 0; --g)
+    {
+        const uint64_t n = b.c[free_before[g]][m.group(g)];
+        ranks[g] = idx % n;
+        idx /= n;
+    }
+
+    BB_T groups[4] = {0, 0, 0, 0};
+    BB_T used = 0;
+    for (int g = 0; g < 4; ++g)
+    {
+        uint64_t rank = ranks[g];
+        for (int i = m.group(g) - 1; i >= 0; --i)
+        {
+            int cell = i;
+            while (b.c[cell + 1][i + 1] <= rank)
+                ++cell;
+            rank -= b.c[cell][i + 1];
+            // cell-    
+            BB_T free_cells = ~used;
+            for (int j = 0; j < cell; ++j)
+                free_cells &= free_cells - 1;
+            groups[g] |= BB_T(1) << low_bit(free_cells);
+        }
+        used |= groups[g];
+    }
+
+    Position pos;
+    pos.white = groups[0] | groups[1];
+    pos.black = groups[2] | groups[3];
+    pos.kings = groups[1] | groups[3];
+    pos.key = pos.calc_key();
+    pos.calc_terms();
+    return pos;
+}
+
+//  ,      .    
+//    
+class Tablebase
+{
+  public:
+    //     ,  false,      
+    bool open(const std::string &path)
+    {
+        memset(tables, 0, sizeof(tables));
+        max_pieces = 0;
+        if (!file.open(path) || file.size() < sizeof(tb_header))
+            return false;
+        tb_header header;
+        memcpy(&header, file.data(), sizeof(header));
+        if (memcmp(header.magic, "CKTB", 4) || header.version != TB_VERSION || header.max_pieces > TB_MAX_PIECES ||
+            file.size() < sizeof(tb_header) + header.tables * sizeof(tb_table_info))
+        {
+            file.close();
+            return false;
+        }
+        for (uint32_t i = 0; i < header.tables; ++i)
+        {
+            tb_table_info info;
+            memcpy(&info, file.data() + sizeof(tb_header) + i * sizeof(tb_table_info), sizeof(info));
+            tb_material m;
+            for (int c = 0; c < 2; ++c)
+            {
+                m.men[c] = info.men[c];
+                m.kings[c] = info.kings[c];
+            }
+            if (m.pieces() > int(header.max_pieces) || info.count != tb_size(m) ||
+                info.offset + info.count > file.size())
+            {
+                file.close();
+                return false;
+            }
+            table(m) = file.data() + info.offset;
+        }
+        max_pieces = int(header.max_pieces);
+        return true;
+    }
+
+    //   ,    , 0 -   
+    int pieces() const
+    {
+        return max_pieces;
+    }
+
+    //      , color -  .  false,   
+    bool probe(const Position &pos, const bool color, tb_outcome &outcome, int &plies) const
+    {
+        const tb_material m(pos);
+        if (m.pieces() > max_pieces)
+            return false;
+        const unsigned char *data = tables[m.men[0]][m.kings[0]][m.men[1]][m.kings[1]];
+        if (!data)
+            return false;
+        outcome = tb_decode(data[tb_index(pos, color)], plies);
+        return true;
+    }
+
+  private:
+    const unsigned char *&table(const tb_material &m)
+    {
+        return tables[m.men[0]][m.kings[0]][m.men[1]][m.kings[1]];
+    }
+
+    Mapped_file file;
+    int max_pieces = 0;
+    //       ,  ,     
+    const unsigned char *tables[TB_MAX_PIECES + 1][TB_MAX_PIECES + 1][TB_MAX_PIECES + 1][TB_MAX_PIECES + 1] = {};
+};
@@ -0,0 +1,167 @@
+#pragma once
+#include <algorithm>
+#include <string>
+#include <vector>
+
+//       SDL    
+#ifdef APPLE
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#else
+#include <SDL.h>
+#include <SDL_image.h>
+#endif
+
+using namespace std;
+
+//  :      PNG     
+// (   )   .        ,
+//          SDL_RenderGeometry
+// ( SDL  2.0.18  ,      SDL_RenderCopy)
+class Texture_atlas
+{
+  public:
+    ~Texture_atlas()
+    {
+        destroy();
+    }
+
+    //     paths  ,   -    paths.
+    //  false,          
+    bool build(SDL_Renderer *ren, const vector<string> &paths)
+    {
+        destroy();
+        vector<SDL_Surface *> images;
+        for (const auto &path : paths)
+        {
+            SDL_Surface *image = IMG_Load(path.c_str());
+            if (!image)
+            {
+                free_surfaces(images);
+                return false;
+            }
+            images.push_back(image);
+        }
+
+        //   , 0 -  
+        SDL_RendererInfo info;
+        int max_w = 4096, max_h = 0;
+        if (SDL_GetRendererInfo(ren, &info) == 0)
+        {
+            if (info.max_texture_width)
+                max_w = info.max_texture_width;
+            max_h = info.max_texture_height;
+        }
+
+        //  :       ,    .
+        //    ,      
+        const int gap = 1;
+        vector<size_t> order(images.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        sort(order.begin(), order.end(), [&](size_t a, size_t b) { return images[a]->h > images[b]->h; });
+        rects.assign(images.size(), SDL_Rect{0, 0, 0, 0});
+        int x = 0, y = 0, shelf_h = 0, atlas_w = 0;
+        for (size_t i : order)
+        {
+            const int w = images[i]->w, h = images[i]->h;
+            if (x && x + w > max_w)
+            {
+                y += shelf_h + gap;
+                x = shelf_h = 0;
+            }
+            rects[i] = SDL_Rect{x, y, w, h};
+            x += w + gap;
+            shelf_h = max(shelf_h, h);
+            atlas_w = max(atlas_w, rects[i].x + w);
+        }
+        const int atlas_h = y + shelf_h;
+        if (atlas_w > max_w || (max_h && atlas_h > max_h))
+        {
+            free_surfaces(images);
+            return false;
+        }
+
+        //       ,  
+        SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, atlas_w, atlas_h, 32, SDL_PIXELFORMAT_RGBA32);
+        bool ok = surface != nullptr;
+        for (size_t i = 0; ok && i < images.size(); ++i)
+        {
+            SDL_SetSurfaceBlendMode(images[i], SDL_BLENDMODE_NONE);
+            ok = SDL_BlitSurface(images[i], nullptr, surface, &rects[i]) == 0;
+        }
+        if (ok)
+            texture = SDL_CreateTextureFromSurface(ren, surface);
+        if (texture)
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        if (surface)
+            SDL_FreeSurface(surface);
+        free_surfaces(images);
+        width = atlas_w;
+        height = atlas_h;
+        return texture != nullptr;
+    }
+
+    //       id,    dst
+    void add(const int id, const SDL_Rect &dst)
+    {
+        const SDL_Rect &src = rects[id];
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        const int base = int(vertices.size());
+        const float u0 = float(src.x) / width, v0 = float(src.y) / height;
+        const float u1 = float(src.x + src.w) / width, v1 = float(src.y + src.h) / height;
+        const float x0 = float(dst.x), y0 = float(dst.y), x1 = float(dst.x + dst.w), y1 = float(dst.y + dst.h);
+        const SDL_Color white{255, 255, 255, 255};
+        vertices.push_back(SDL_Vertex{SDL_FPoint{x0, y0}, white, SDL_FPoint{u0, v0}});
+        vertices.push_back(SDL_Vertex{SDL_FPoint{x1, y0}, white, SDL_FPoint{u1, v0}});
+        vertices.push_back(SDL_Vertex{SDL_FPoint{x1, y1}, white, SDL_FPoint{u1, v1}});
+        vertices.push_back(SDL_Vertex{SDL_FPoint{x0, y1}, white, SDL_FPoint{u0, v1}});
+        for (const int k : {0, 1, 2, 0, 2, 3})
+            indices.push_back(base + k);
+#else
+        copies.emplace_back(src, dst);
+#endif
+    }
+
+    //        
+    void flush(SDL_Renderer *ren)
+    {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        if (!vertices.empty())
+            SDL_RenderGeometry(ren, texture, vertices.data(), int(vertices.size()), indices.data(),
+                               int(indices.size()));
+        vertices.clear();
+        indices.clear();
+#else
+        for (const auto &copy : copies)
+            SDL_RenderCopy(ren, texture, &copy.first, &copy.second);
+        copies.clear();
+#endif
+    }
+
+    //     
+    void destroy()
+    {
+        if (texture)
+            SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+
+  private:
+    static void free_surfaces(vector<SDL_Surface *> &images)
+    {
+        for (auto image : images)
+            SDL_FreeSurface(image);
+        images.clear();
+    }
+
+    SDL_Texture *texture = nullptr; //  
+    int width = 0, height = 0;      //  
+    vector<SDL_Rect> rects;         //     
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    vector<SDL_Vertex> vertices; //  ,    
+    vector<int> indices;         //    
+#else
+    vector<pair<SDL_Rect, SDL_Rect>> copies; //  (, )  SDL_RenderCopy
+#endif
+};
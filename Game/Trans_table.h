@@ -0,0 +1,116 @@
+#pragma once
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "../Models/Move.h"
+
+//  ,    
+enum class Bound : uint8_t
+{
+    EXACT, //  
+    LOWER, //     (   beta)
+    UPPER  //     (     alpha)
+};
+
+//   
+struct tt_entry
+{
+    uint64_t key = 0;                         //      
+    double score = 0;                         //      
+    move_pos best = move_pos(-1, -1, -1, -1); //   ( ,   -  )
+    int8_t depth = -1;                        //  ,    , -1 -  
+    Bound bound = Bound::EXACT;               //  
+};
+
+//         
+//          :    ,
+//    - ,   xor   .      
+//    ,         
+class Trans_table
+{
+public:
+    Trans_table() = default;
+
+    //        size_mb , 0 -  
+    void resize(const size_t size_mb)
+    {
+        size_t n = 1;
+        while (n * 2 * sizeof(tt_slot) <= size_mb * 1024 * 1024)
+            n *= 2; //   -  ,    
+        table = std::vector<tt_slot>(size_mb ? n : 0);
+        mask = n - 1;
+    }
+
+    //     
+    void clear()
+    {
+        for (auto& slot : table)
+        {
+            slot.check.store(0, std::memory_order_relaxed);
+            slot.score.store(0, std::memory_order_relaxed);
+            slot.info.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    //     ,  false,     
+    bool probe(const uint64_t key, tt_entry& res) const
+    {
+        if (table.empty())
+            return false;
+        const tt_slot& slot = table[key & mask];
+        const uint64_t score = slot.score.load(std::memory_order_relaxed);
+        const uint64_t info = slot.info.load(std::memory_order_relaxed);
+        if ((slot.check.load(std::memory_order_relaxed) ^ score ^ info) != key || !(info >> 48 & 0xFF))
+            return false;
+        unpack(key, score, info, res);
+        return true;
+    }
+
+    //      
+    void store(const uint64_t key, const double score, const int depth, const Bound bound, const move_pos best)
+    {
+        if (table.empty())
+            return;
+        tt_slot& slot = table[key & mask];
+        const uint64_t old_score = slot.score.load(std::memory_order_relaxed);
+        const uint64_t old_info = slot.info.load(std::memory_order_relaxed);
+        //      ,    
+        if ((slot.check.load(std::memory_order_relaxed) ^ old_score ^ old_info) == key &&
+            int(old_info >> 48 & 0xFF) - 1 > depth)
+            return;
+        uint64_t score_bits;
+        memcpy(&score_bits, &score, sizeof(score));
+        const uint64_t info = uint64_t(uint8_t(best.x)) | uint64_t(uint8_t(best.y)) << 8 | uint64_t(uint8_t(best.x2)) << 16 |
+                              uint64_t(uint8_t(best.y2)) << 24 | uint64_t(uint8_t(best.xb)) << 32 |
+                              uint64_t(uint8_t(best.yb)) << 40 | uint64_t(uint8_t(depth + 1)) << 48 |
+                              uint64_t(uint8_t(bound)) << 56;
+        slot.check.store(key ^ score_bits ^ info, std::memory_order_relaxed);
+        slot.score.store(score_bits, std::memory_order_relaxed);
+        slot.info.store(info, std::memory_order_relaxed);
+    }
+
+private:
+    //  :  ,     ,    
+    struct tt_slot
+    {
+        std::atomic<uint64_t> check{0};
+        std::atomic<uint64_t> score{0};
+        std::atomic<uint64_t> info{0};
+    };
+
+    //    
+    static void unpack(const uint64_t key, const uint64_t score, const uint64_t info, tt_entry& res)
+    {
+        res.key = key;
+        memcpy(&res.score, &score, sizeof(score));
+        res.best = move_pos(POS_T(info), POS_T(info >> 8), POS_T(info >> 16), POS_T(info >> 24), POS_T(info >> 32),
+                            POS_T(info >> 40));
+        res.depth = int8_t((info >> 48 & 0xFF) - 1);
+        res.bound = Bound(info >> 56);
+    }
+
+    std::vector<tt_slot> table; //  
+    size_t mask = 0; //       
+};
@@ -0,0 +1,107 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stddef.h>
+#include <utility>
+#include <vector>
+
+//      (work stealing):     ,  
+//   .       ,     -   ,
+//      ,     ,      
+//   .     :  ,   
+//       
+template <class T> class Work_pool
+{
+  public:
+    Work_pool(const size_t workers, const size_t max_queued)
+        : queues(workers < 1 ? 1 : workers), max_queued(max_queued < 1 ? 1 : max_queued)
+    {
+    }
+
+    //    ,   -. ,     
+    void push(T task)
+    {
+        {
+            std::unique_lock<std::mutex> lock(wait_mutex);
+            has_space.wait(lock, [&] { return pending < max_queued; });
+        }
+        queue &q = queues[next_queue];
+        next_queue = (next_queue + 1) % queues.size();
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(task));
+            ++pending; //   :    ,   
+        }
+        std::lock_guard<std::mutex> lock(wait_mutex); //        
+        has_task.notify_one();
+    }
+
+    //    :   , pop  false
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex);
+        closed = true;
+        has_task.notify_all();
+    }
+
+    //      worker.  ,  false,     
+    bool pop(const size_t worker, T &task)
+    {
+        while (true)
+        {
+            if (take(worker, task))
+                return true;
+            std::unique_lock<std::mutex> lock(wait_mutex);
+            has_task.wait(lock, [&] { return pending > 0 || closed; });
+            if (pending == 0 && closed)
+                return false;
+        }
+    }
+
+  private:
+    struct queue
+    {
+        std::mutex mutex;
+        std::deque<T> tasks;
+    };
+
+    //    ,    ,   
+    bool take(const size_t worker, T &task)
+    {
+        for (size_t k = 0; k < queues.size(); ++k)
+        {
+            queue &q = queues[(worker + k) % queues.size()];
+            std::unique_lock<std::mutex> lock(q.mutex);
+            if (q.tasks.empty())
+                continue;
+            if (k == 0)
+            {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+            lock.unlock();
+            if (pending-- == max_queued)
+            {
+                std::lock_guard<std::mutex> wait_lock(wait_mutex);
+                has_space.notify_one(); //   
+            }
+            return true;
+        }
+        return false;
+    }
+
+    std::vector<queue> queues;
+    const size_t max_queued;
+    size_t next_queue = 0;          //    ,   
+    std::atomic<size_t> pending{0}; //   
+    bool closed = false;            //    ,  wait_mutex
+    std::mutex wait_mutex;          //    
+    std::condition_variable has_task, has_space;
+};
@@ -0,0 +1,187 @@
+#pragma once
+#include <algorithm>
+#include <stdint.h>
+#include <vector>
+
+#include "Move.h"
+#include "Position.h"
+
+//     : 4    .    
+// ,          
+struct history_entry
+{
+    uint8_t from;            //  ,   (0..31)
+    uint8_t to;              //  ,  
+    uint8_t beaten;          //    , NO_BEATEN -   
+    uint8_t beaten_type : 3; //       
+    uint8_t promoted : 1;    //   
+    uint8_t series : 4;      //      (1, 2, ...), 0 -  
+
+    static const uint8_t NO_BEATEN = 0xFF;
+
+    //    
+    move_pos turn() const
+    {
+        const Rays& r = rays();
+        if (beaten == NO_BEATEN)
+            return move_pos(r.x[from], r.y[from], r.x[to], r.y[to]);
+        return move_pos(r.x[from], r.y[from], r.x[to], r.y[to], r.x[beaten], r.y[beaten]);
+    }
+
+    //      Position
+    undo_info undo() const
+    {
+        undo_info res;
+        res.beaten = POS_T(beaten_type);
+        res.promoted = promoted;
+        return res;
+    }
+};
+
+//  :          CHECKPOINT_PLIES .
+//     -      , O(1).    
+//  ,      .       
+//    .    100    400 
+class Move_history
+{
+  public:
+    static const size_t CHECKPOINT_PLIES = 64;
+
+    explicit Move_history(const Position& start = Position::start())
+    {
+        reset(start);
+    }
+
+    //        start
+    void reset(const Position& start)
+    {
+        entries.clear();
+        checkpoints.assign(1, pack(start));
+        cursor = 0;
+        current = start;
+    }
+
+    //     turn,    , series -     .
+    //     .   
+    const history_entry& push(const move_pos& turn, const int series)
+    {
+        entries.resize(cursor);
+        checkpoints.resize(cursor / CHECKPOINT_PLIES + 1);
+        const undo_info undo = current.make_turn(turn);
+        history_entry e;
+        e.from = uint8_t(cell_index(turn.x, turn.y));
+        e.to = uint8_t(cell_index(turn.x2, turn.y2));
+        e.beaten = turn.xb == -1 ? history_entry::NO_BEATEN : uint8_t(cell_index(turn.xb, turn.yb));
+        e.beaten_type = uint8_t(undo.beaten);
+        e.promoted = undo.promoted;
+        e.series = uint8_t(series);
+        entries.push_back(e);
+        advance();
+        return entries.back();
+    }
+
+    //    
+    bool can_undo() const
+    {
+        return cursor > 0;
+    }
+
+    //     
+    bool can_redo() const
+    {
+        return cursor < entries.size();
+    }
+
+    //     ,   
+    const history_entry& undo()
+    {
+        const history_entry& e = entries[--cursor];
+        current.unmake_turn(e.turn(), e.undo());
+        return e;
+    }
+
+    //     ,   
+    const history_entry& redo()
+    {
+        const history_entry& e = entries[cursor];
+        current.make_turn(e.turn());
+        advance();
+        return e;
+    }
+
+    //   ,     
+    const history_entry& back() const
+    {
+        return entries[cursor - 1];
+    }
+
+    // ,    redo,    
+    const history_entry& next() const
+    {
+        return entries[cursor];
+    }
+
+    //     ply ( )
+    const history_entry& operator[](const size_t ply) const
+    {
+        return entries[ply];
+    }
+
+    //    (   -  )
+    size_t size() const
+    {
+        return cursor;
+    }
+
+    //     
+    const Position& position() const
+    {
+        return current;
+    }
+
+    //   ply :       CHECKPOINT_PLIES 
+    Position position_at(const size_t ply) const
+    {
+        const size_t k = std::min(ply / CHECKPOINT_PLIES, checkpoints.size() - 1);
+        Position pos = unpack(checkpoints[k]);
+        for (size_t i = k * CHECKPOINT_PLIES; i < ply; ++i)
+            pos.make_turn(entries[i].turn());
+        return pos;
+    }
+
+  private:
+    //  :   
+    struct packed_position
+    {
+        BB_T white, black, kings;
+    };
+
+    static packed_position pack(const Position& pos)
+    {
+        return packed_position{pos.white, pos.black, pos.kings};
+    }
+
+    static Position unpack(const packed_position& packed)
+    {
+        Position pos;
+        pos.white = packed.white;
+        pos.black = packed.black;
+        pos.kings = packed.kings;
+        pos.key = pos.calc_key();
+        pos.calc_terms();
+        return pos;
+    }
+
+    //      ,    CHECKPOINT_PLIES    
+    void advance()
+    {
+        ++cursor;
+        if (cursor % CHECKPOINT_PLIES == 0 && checkpoints.size() <= cursor / CHECKPOINT_PLIES)
+            checkpoints.push_back(pack(current));
+    }
+
+    std::vector<history_entry> entries;        //  ,  
+    std::vector<packed_position> checkpoints; //   0, CHECKPOINT_PLIES, 2 * CHECKPOINT_PLIES ... 
+    size_t cursor = 0;                        //   
+    Position current;                         //    
+};
@@ -0,0 +1,374 @@
+#pragma once
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "Move.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+typedef uint32_t BB_T; //    32    ( =  )
+
+//     
+inline int pop_count(const BB_T b)
+{
+#ifdef _MSC_VER
+    return int(__popcnt(b));
+#else
+    return __builtin_popcount(b);
+#endif
+}
+
+//    ,     
+inline int low_bit(const BB_T b)
+{
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanForward(&idx, b);
+    return int(idx);
+#else
+    return __builtin_ctz(b);
+#endif
+}
+
+//    (0..31)     8x8,   - ,  (x + y) 
+inline int cell_index(const POS_T x, const POS_T y)
+{
+    return x * 4 + y / 2;
+}
+
+//        
+// : 0 - (-1, -1), 1 - (-1, +1), 2 - (+1, -1), 3 - (+1, +1)
+//      0  1,  -  2  3
+struct Rays
+{
+    POS_T x[32], y[32];   //       
+    int8_t ray[32][4][7]; //         
+    int8_t len[32][4];    //     
+    BB_T row[8];          //  
+
+    Rays()
+    {
+        for (int i = 0; i < 8; ++i)
+            row[i] = 0;
+        for (POS_T i = 0; i < 8; ++i)
+        {
+            for (POS_T j = 0; j < 8; ++j)
+            {
+                if ((i + j) % 2 == 0)
+                    continue;
+                const int s = cell_index(i, j);
+                x[s] = i;
+                y[s] = j;
+                row[i] |= BB_T(1) << s;
+                for (int d = 0; d < 4; ++d)
+                {
+                    const POS_T di = (d < 2 ? -1 : 1), dj = (d % 2 ? 1 : -1);
+                    len[s][d] = 0;
+                    for (POS_T i2 = i + di, j2 = j + dj; i2 >= 0 && i2 < 8 && j2 >= 0 && j2 < 8; i2 += di, j2 += dj)
+                        ray[s][d][len[s][d]++] = int8_t(cell_index(i2, j2));
+                }
+            }
+        }
+    }
+};
+
+//      (   )
+inline const Rays& rays()
+{
+    static const Rays r;
+    return r;
+}
+
+//      
+struct Zobrist
+{
+    uint64_t piece[4][32]; //     (1..4   )   
+    uint64_t side;         //    
+    uint64_t bot;          //   ,      
+
+    Zobrist()
+    {
+        //   splitmix64,     
+        uint64_t seed = 0x9E3779B97F4A7C15ull;
+        auto next = [&seed]() {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        };
+        for (int t = 0; t < 4; ++t)
+            for (int s = 0; s < 32; ++s)
+                piece[t][s] = next();
+        side = next();
+        bot = next();
+    }
+};
+
+//     
+inline const Zobrist& zobrist()
+{
+    static const Zobrist z;
+    return z;
+}
+
+// ,    
+struct undo_info
+{
+    POS_T beaten = 0;      //       , 0 -   
+    bool promoted = false; //     
+};
+
+//   :   ,      32  
+struct Position
+{
+    BB_T white = 0; //     (1  3   )
+    BB_T black = 0; //     (2  4   )
+    BB_T kings = 0; //    (3  4   )
+    uint64_t key = 0; //    ,    
+    //     (0 - , 1 - ),    
+    int8_t men_count[2] = { 0, 0 };  //  
+    int8_t king_count[2] = { 0, 0 }; //  
+    int16_t potential[2] = { 0, 0 }; //   :   
+
+    Position() = default;
+
+    //     : 1 - , 2 - , 3 -  , 4 -  
+    explicit Position(const std::vector<std::vector<POS_T>>& mtx)
+    {
+        const Rays& r = rays();
+        for (int s = 0; s < 32; ++s)
+        {
+            const POS_T type = mtx[r.x[s]][r.y[s]];
+            if (!type)
+                continue;
+            const BB_T bit = BB_T(1) << s;
+            (type % 2 ? white : black) |= bit;
+            if (type > 2)
+                kings |= bit;
+        }
+        key = calc_key();
+        calc_terms();
+    }
+
+    //      8x8
+    std::vector<std::vector<POS_T>> to_mtx() const
+    {
+        std::vector<std::vector<POS_T>> mtx(8, std::vector<POS_T>(8, 0));
+        const Rays& r = rays();
+        for (int s = 0; s < 32; ++s)
+            mtx[r.x[s]][r.y[s]] = get(s);
+        return mtx;
+    }
+
+    //       s     (0 - )
+    POS_T get(const int s) const
+    {
+        const BB_T bit = BB_T(1) << s;
+        if (!((white | black) & bit))
+            return 0;
+        return POS_T((white & bit ? 1 : 2) + (kings & bit ? 2 : 0));
+    }
+
+    //      
+    uint64_t calc_key() const
+    {
+        const Zobrist& z = zobrist();
+        uint64_t res = 0;
+        for (BB_T b = occupied(); b; b &= b - 1)
+        {
+            const int s = low_bit(b);
+            res ^= z.piece[get(s) - 1][s];
+        }
+        return res;
+    }
+
+    //    color   s:     0,  -   7
+    static int advance(const bool color, const int s)
+    {
+        return color ? s / 4 : 7 - s / 4;
+    }
+
+    //      
+    void calc_terms()
+    {
+        for (int c = 0; c < 2; ++c)
+        {
+            const BB_T men = pieces(c != 0) & ~kings;
+            men_count[c] = int8_t(pop_count(men));
+            king_count[c] = int8_t(pop_count(pieces(c != 0) & kings));
+            potential[c] = 0;
+            for (BB_T b = men; b; b &= b - 1)
+                potential[c] += int16_t(advance(c != 0, low_bit(b)));
+        }
+    }
+
+    //       s      ,   
+    POS_T remove_piece(const int s)
+    {
+        const POS_T type = get(s);
+        const bool color = !(type % 2);
+        const BB_T keep = ~(BB_T(1) << s);
+        white &= keep;
+        black &= keep;
+        kings &= keep;
+        key ^= zobrist().piece[type - 1][s];
+        if (type > 2)
+            --king_count[color];
+        else
+        {
+            --men_count[color];
+            potential[color] -= int16_t(advance(color, s));
+        }
+        return type;
+    }
+
+    //      type    s      
+    void put_piece(const int s, const POS_T type)
+    {
+        const bool color = !(type % 2);
+        const BB_T bit = BB_T(1) << s;
+        (color ? black : white) |= bit;
+        if (type > 2)
+        {
+            kings |= bit;
+            ++king_count[color];
+        }
+        else
+        {
+            ++men_count[color];
+            potential[color] += int16_t(advance(color, s));
+        }
+        key ^= zobrist().piece[type - 1][s];
+    }
+
+    //      ,     
+    undo_info make_turn(const move_pos& turn)
+    {
+        undo_info undo;
+        if (turn.xb != -1)
+            undo.beaten = remove_piece(cell_index(turn.xb, turn.yb)); //   
+        POS_T type = remove_piece(cell_index(turn.x, turn.y));
+        //      
+        if ((type == 1 && turn.x2 == 0) || (type == 2 && turn.x2 == 7))
+        {
+            type += 2;
+            undo.promoted = true;
+        }
+        put_piece(cell_index(turn.x2, turn.y2), type);
+        return undo;
+    }
+
+    //    ,  make_turn
+    void unmake_turn(const move_pos& turn, const undo_info& undo)
+    {
+        POS_T type = remove_piece(cell_index(turn.x2, turn.y2));
+        if (undo.promoted)
+            type -= 2;
+        put_piece(cell_index(turn.x, turn.y), type);
+        if (undo.beaten)
+            put_piece(cell_index(turn.xb, turn.yb), undo.beaten);
+    }
+
+    //   : false - , true -  (  Logic)
+    BB_T pieces(const bool color) const
+    {
+        return color ? black : white;
+    }
+
+    //   
+    BB_T occupied() const
+    {
+        return white | black;
+    }
+
+    //  :     ,    
+    static Position start()
+    {
+        Position pos;
+        const Rays& r = rays();
+        pos.black = r.row[0] | r.row[1] | r.row[2];
+        pos.white = r.row[5] | r.row[6] | r.row[7];
+        pos.key = pos.calc_key();
+        pos.calc_terms();
+        return pos;
+    }
+
+    //    FEN  PDN: "W:W21,22,K30:B1,2,K5" -  ,    ,
+    // K - .   1..32     + 1: 1..4 -  
+    // ( )  , 29..32 - .  false,   
+    static bool from_fen(const std::string& fen, Position& pos, bool& color)
+    {
+        pos = Position();
+        size_t i = 0;
+        auto skip_spaces = [&]() {
+            while (i < fen.size() && (fen[i] == ' ' || fen[i] == '"' || fen[i] == '\t'))
+                ++i;
+        };
+        skip_spaces();
+        if (i >= fen.size() || (fen[i] != 'W' && fen[i] != 'B'))
+            return false;
+        color = fen[i++] == 'B';
+        //   ,    ":W"  ":B"
+        while (i < fen.size() && fen[i] == ':')
+        {
+            ++i;
+            if (i >= fen.size() || (fen[i] != 'W' && fen[i] != 'B'))
+                return false;
+            BB_T& side = fen[i++] == 'W' ? pos.white : pos.black;
+            while (i < fen.size() && fen[i] != ':')
+            {
+                if (fen[i] == ',' || fen[i] == ' ')
+                {
+                    ++i;
+                    continue;
+                }
+                if (fen[i] == '.' || fen[i] == '"')
+                    break; //  
+                const bool is_king = fen[i] == 'K';
+                if (is_king)
+                    ++i;
+                int num = 0, digits = 0;
+                for (; i < fen.size() && fen[i] >= '0' && fen[i] <= '9'; ++i, ++digits)
+                    num = num * 10 + (fen[i] - '0');
+                if (!digits || num < 1 || num > 32)
+                    return false;
+                const BB_T bit = BB_T(1) << (num - 1);
+                side |= bit;
+                if (is_king)
+                    pos.kings |= bit;
+            }
+            if (i < fen.size() && (fen[i] == '.' || fen[i] == '"'))
+                break;
+        }
+        if (pos.white & pos.black)
+            return false; //      
+        pos.key = pos.calc_key();
+        pos.calc_terms();
+        return true;
+    }
+
+    //     FEN, color -   (false - , true - )
+    std::string to_fen(const bool color) const
+    {
+        std::string res = color ? "B" : "W";
+        for (int side = 0; side < 2; ++side)
+        {
+            res += side ? ":B" : ":W";
+            bool first = true;
+            for (BB_T b = pieces(side != 0); b; b &= b - 1)
+            {
+                const int s = low_bit(b);
+                if (!first)
+                    res += ',';
+                first = false;
+                if (kings >> s & 1)
+                    res += 'K';
+                res += std::to_string(s + 1);
+            }
+        }
+        return res;
+    }
+};
@@ -1,5 +1,8 @@
+#pragma once
+#include <string>
+
 #ifdef __APPLE__
-    #define  project_path string("../../../cpp_lesson/")
+    #define  project_path std::string("../../../cpp_lesson/")
 #else
-    #define  project_path string("")
+    #define  project_path std::string("")
 #endif
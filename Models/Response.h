@@ -16,5 +16,8 @@ enum class Response
     QUIT,
 
     // ,             
-    CELL
+    CELL,
+
+    // , ,     ,    
+    FORCE
 };
\ No newline at end of file
@@ -0,0 +1,218 @@
+//    :       ,   
+//      ,       JSON
+// : analyze [] [] [key=value ...]
+//             FEN   ( FEN      ,  
+//                 tournament -record)   PDN -       .
+//                   "-" -  . PDN    : FEN   W, B  "
+//   -depth N       (  BlackBotLevel)
+//   -time MS        ,     -depth
+//   -threads N     (    ),     
+//   key=value       Bot settings.json,   tournament,  HashSizeMB=16 - 
+//                    .    ,    BookPath
+//  : {"id":1,"fen":"W:W21,...:B1,...","best":"15x22x31","score":1.5,"depth":9,"nodes":12345,"ms":8.2},
+// id -    ,  PDN  "game"  "ply". score -    ,  ,
+//   : 1 - , 0 - .  stderr - :       
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+
+#include "../Game/Config.h"
+#include "../Game/Logic.h"
+#include "../Game/Pdn.h"
+#include "../Game/Work_pool.h"
+
+//   
+struct analysis_task
+{
+    size_t id = 0;
+    Position pos;
+    bool color = false;
+    size_t game = 0; //   PDN, 0 -    FEN
+    size_t ply = 0;  //    
+};
+
+int main(int argc, char* argv[])
+{
+    Config config;
+    int depth = config("Bot", "BlackBotLevel");
+    int threads_num = max(1, int(thread::hardware_concurrency()));
+    string input_path = "-";
+    //    ,      
+    config.set("Bot", "Threads", 1);
+    config.set("Bot", "MoveTimeMS", 0);
+    config.set("Bot", "BookPath", "");
+    for (int i = 1; i < argc; ++i)
+    {
+        const string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        const size_t eq = arg.find('=');
+        if (arg == "-depth" && has_value)
+            depth = atoi(argv[++i]);
+        else if (arg == "-time" && has_value)
+            config.set("Bot", "MoveTimeMS", max(0, atoi(argv[++i])));
+        else if (arg == "-threads" && has_value)
+            threads_num = max(1, atoi(argv[++i]));
+        else if (eq != string::npos && arg[0] != '-')
+            config.set_parsed("Bot", arg.substr(0, eq), arg.substr(eq + 1));
+        else if (arg == "-" || arg[0] != '-')
+            input_path = arg;
+        else
+        {
+            cerr << "usage: analyze [file] [-depth N] [-time MS] [-threads N] [key=value ...]\n";
+            return 2;
+        }
+    }
+    if (depth < 1)
+    {
+        cerr << "bad depth " << depth << "\n";
+        return 2;
+    }
+
+    ifstream file;
+    if (input_path != "-")
+    {
+        file.open(input_path, ios_base::binary);
+        if (!file)
+        {
+            cerr << "cannot read " << input_path << "\n";
+            return 1;
+        }
+    }
+    istream& in = input_path == "-" ? cin : file;
+
+    //      :   ,      
+    Work_pool<analysis_task> pool(threads_num, threads_num * 64);
+    mutex output_mutex;
+    size_t positions = 0, total_nodes = 0;
+    auto start = chrono::steady_clock::now();
+
+    auto worker = [&](const size_t index) {
+        Logic logic(&config);
+        logic.Max_depth = depth;
+        search_info last;
+        logic.set_progress([&](const search_info& info) { last = info; });
+        analysis_task task;
+        while (pool.pop(index, task))
+        {
+            json res;
+            res["id"] = task.id;
+            if (task.game)
+            {
+                res["game"] = task.game;
+                res["ply"] = task.ply;
+            }
+            res["fen"] = task.pos.to_fen(task.color);
+            logic.set_position(task.pos);
+            logic.find_turns(task.color);
+            last = search_info();
+            if (logic.turns.empty())
+            {
+                res["best"] = nullptr; //   - 
+                res["score"] = 0;
+            }
+            else
+            {
+                const vector<move_pos> best = logic.find_best_turns(task.color);
+                res["best"] = pdn_move_text(best);
+                res["score"] = last.score;
+            }
+            res["depth"] = last.depth;
+            res["nodes"] = last.nodes;
+            res["ms"] = last.ms;
+            const string line = res.dump();
+            lock_guard<mutex> lock(output_mutex);
+            cout << line << endl;
+            ++positions;
+            total_nodes += last.nodes;
+        }
+    };
+    vector<thread> workers;
+    for (int i = 0; i < threads_num; ++i)
+        workers.emplace_back(worker, size_t(i));
+
+    //     :     
+    size_t next_id = 0, bad = 0;
+    in >> ws;
+    const int first = in.peek();
+    if (first == 'W' || first == 'B' || first == '"' || first == EOF)
+    {
+        string line;
+        size_t line_num = 0;
+        while (getline(in, line))
+        {
+            ++line_num;
+            // FEN -   ,   Tools/tune.cpp
+            stringstream ss(line);
+            string fen;
+            if (!(ss >> fen))
+                continue;
+            analysis_task task;
+            if (!Position::from_fen(fen, task.pos, task.color))
+            {
+                if (bad++ < 20)
+                    cerr << "line " << line_num << ": bad FEN\n";
+                continue;
+            }
+            task.id = ++next_id;
+            pool.push(task);
+        }
+    }
+    else
+    {
+        // PDN     :    ,    
+        Pdn_reader reader;
+        string data;
+        if (input_path == "-")
+        {
+            data.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+            reader.set_data(data.data(), data.size());
+        }
+        else if (!reader.open(input_path))
+        {
+            cerr << "cannot read " << input_path << "\n";
+            pool.close();
+            for (auto& w : workers)
+                w.join();
+            return 1;
+        }
+        Logic logic(&config);
+        Pdn_replay replay(logic);
+        pdn_game game;
+        vector<pair<Position, bool>> game_positions;
+        size_t games = 0;
+        while (reader.next(game))
+        {
+            ++games;
+            string error = game.error;
+            game_positions.clear();
+            //         
+            if (!error.empty() || !replay.replay(game, &game_positions, error))
+                if (bad++ < 20)
+                    cerr << "game " << games << ": " << error << "\n";
+            for (size_t ply = 0; ply < game_positions.size(); ++ply)
+            {
+                analysis_task task;
+                task.id = ++next_id;
+                task.pos = game_positions[ply].first;
+                task.color = game_positions[ply].second;
+                task.game = games;
+                task.ply = ply;
+                pool.push(task);
+            }
+        }
+    }
+    pool.close();
+    for (auto& w : workers)
+        w.join();
+
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    const double rate = positions / max(seconds, 1e-9);
+    cerr << positions << " positions, " << threads_num << " threads, " << seconds << " s, " << rate
+         << " positions/s, " << rate / threads_num << " positions/s per thread, "
+         << total_nodes / max(seconds, 1e-9) / 1e6 << " Mnodes/s" << endl;
+    return bad ? 1 : 0;
+}
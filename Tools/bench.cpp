@@ -0,0 +1,43 @@
+//       SDL:       
+// : bench [] [ ]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "../Game/Config.h"
+#include "../Game/Logic.h"
+
+int main(int argc, char* argv[])
+{
+    Config config;
+    const int depth = argc > 1 ? atoi(argv[1]) : int(config("Bot", "BlackBotLevel")); //  
+    const int max_turns = argc > 2 ? atoi(argv[2]) : 20; //    
+
+    Logic logic(&config);
+    logic.Max_depth = depth;
+    logic.set_position(Position::start());
+
+    size_t total_nodes = 0;
+    double total_ms = 0;
+    for (int turn_num = 0; turn_num < max_turns; ++turn_num)
+    {
+        const bool color = turn_num % 2;
+        logic.find_turns(color);
+        if (logic.turns.empty())
+            break; //  
+
+        auto start = chrono::steady_clock::now();
+        auto turns = logic.find_best_turns(color);
+        auto end = chrono::steady_clock::now();
+        const double ms = chrono::duration<double, milli>(end - start).count();
+
+        for (auto turn : turns)
+            logic.make_turn(turn);
+        total_nodes += logic.nodes;
+        total_ms += ms;
+        cout << "turn " << turn_num << ": depth " << logic.last_depth << ", " << logic.nodes << " nodes, " << ms << " ms\n";
+    }
+    cout << "depth " << depth << ": " << total_nodes << " nodes, " << total_ms << " ms, "
+         << (total_ms > 0 ? size_t(total_nodes / total_ms * 1000) : 0) << " nodes/sec\n";
+    return 0;
+}
@@ -0,0 +1,155 @@
+//     Game/Opening_book.h     
+// : bookgen [] [] [] []
+//       -   (  200)
+//      -     (  BlackBotLevel  settings.json)
+//    -           (  10)
+//         -   (  opening.cbk)
+//       ,    .    
+// :    ,  
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+
+#include "../Game/Config.h"
+#include "../Game/Logic.h"
+#include "../Game/Opening_book.h"
+
+typedef array<uint8_t, BOOK_PATH_LEN> book_path;
+
+//    
+struct move_stats
+{
+    uint32_t games = 0;
+    uint32_t points = 0;
+};
+
+//     turns   , false -   
+bool to_path(const vector<move_pos>& turns, book_path& path)
+{
+    if (turns.size() >= size_t(BOOK_PATH_LEN))
+        return false;
+    path.fill(BOOK_NO_CELL);
+    path[0] = uint8_t(cell_index(turns[0].x, turns[0].y));
+    for (size_t i = 0; i < turns.size(); ++i)
+        path[i + 1] = uint8_t(cell_index(turns[i].x2, turns[i].y2));
+    return true;
+}
+
+//   :        
+vector<move_pos> random_turn(Logic& logic, const bool color, mt19937& rng)
+{
+    const Position saved = logic.get_position();
+    vector<move_pos> res;
+    logic.find_turns(color);
+    while (!logic.turns.empty())
+    {
+        const move_pos turn = logic.turns[rng() % logic.turns.size()];
+        res.push_back(turn);
+        if (turn.xb == -1)
+            break;
+        logic.make_turn(turn);
+        logic.find_turns(turn.x2, turn.y2);
+        if (!logic.have_beats)
+            break; //   
+    }
+    logic.set_position(saved);
+    return res;
+}
+
+int main(int argc, char* argv[])
+{
+    Config config;
+    config.set("Bot", "MoveTimeMS", 0); //        
+    const int games = argc > 1 ? atoi(argv[1]) : 200;
+    const int depth = argc > 2 ? atoi(argv[2]) : int(config("Bot", "BlackBotLevel"));
+    const int book_plies = argc > 3 ? atoi(argv[3]) : 10;
+    const string path = argc > 4 ? argv[4] : "opening.cbk";
+    const int max_turns = config("Game", "MaxNumTurns");
+    const int random_plies = 2;
+
+    Logic logic(&config);
+    logic.set_book(nullptr); //   ,      
+    logic.Max_depth = depth;
+    mt19937 rng(unsigned(time(0)));
+
+    map<pair<uint64_t, book_path>, move_stats> stats;
+    int results[3] = {0, 0, 0}; //  ,  , 
+    auto start = chrono::steady_clock::now();
+    for (int game = 0; game < games; ++game)
+    {
+        logic.set_position(Position::start());
+        vector<pair<pair<uint64_t, book_path>, bool>> played; //     
+        int winner = -1;                                       // -1 -    
+        for (int turn_num = 0; turn_num < max_turns; ++turn_num)
+        {
+            const bool color = turn_num % 2;
+            logic.find_turns(color);
+            if (logic.turns.empty())
+            {
+                winner = !color; //   - 
+                break;
+            }
+            const Position pos = logic.get_position();
+            vector<move_pos> turns =
+                turn_num < random_plies ? random_turn(logic, color, rng) : logic.find_best_turns(color);
+            logic.set_position(pos);
+            book_path cells;
+            if (turn_num >= random_plies && turn_num < book_plies && to_path(turns, cells))
+                played.push_back({{book_key(pos, color), cells}, color});
+            for (auto turn : turns)
+                logic.make_turn(turn);
+        }
+        results[winner == -1 ? 2 : winner]++;
+        for (const auto& p : played)
+        {
+            move_stats& s = stats[p.first];
+            ++s.games;
+            s.points += winner == -1 ? 1 : (winner == int(p.second) ? 2 : 0);
+        }
+        if ((game + 1) % 10 == 0 || game + 1 == games)
+            cout << "games " << game + 1 << ": white " << results[0] << ", black " << results[1] << ", draws "
+                 << results[2] << ", " << stats.size() << " book moves, "
+                 << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s" << endl;
+    }
+
+    //     ,   -   
+    vector<book_entry> entries;
+    entries.reserve(stats.size());
+    for (const auto& s : stats)
+    {
+        book_entry e;
+        e.key = s.first.first;
+        memcpy(e.path, s.first.second.data(), BOOK_PATH_LEN);
+        e.games = s.second.games;
+        e.points = s.second.points;
+        entries.push_back(e);
+    }
+    sort(entries.begin(), entries.end(), [](const book_entry& a, const book_entry& b) {
+        return a.key != b.key ? a.key < b.key : a.points > b.points;
+    });
+
+    FILE* fout = fopen(path.c_str(), "wb");
+    if (!fout)
+    {
+        cerr << "cannot write " << path << "\n";
+        return 1;
+    }
+    book_header header;
+    memcpy(header.magic, "CKBK", 4);
+    header.version = BOOK_VERSION;
+    header.count = entries.size();
+    fwrite(&header, sizeof(header), 1, fout);
+    fwrite(entries.data(), sizeof(book_entry), entries.size(), fout);
+    const bool ok = !ferror(fout);
+    fclose(fout);
+    if (!ok)
+    {
+        cerr << "cannot write " << path << "\n";
+        return 1;
+    }
+    cout << "Written " << path << ", " << entries.size() << " moves" << endl;
+    return 0;
+}
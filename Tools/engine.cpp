@@ -0,0 +1,404 @@
+//         UCI:        ,
+//    .     PDN: "22-18",    "15x22x31".
+//            
+// : engine [key=value ...] -    Bot settings.json,   tournament,
+//                Level -   
+// :
+//   uci                            : id, option   , uciok
+//   isready                         readyok
+//   setoption name <X> value <Y>    X  Bot, Level -    
+//   ucinewgame                      ,   
+//   position startpos|fen <FEN> [moves <> ...]
+//   go [depth N] [nodes N] [movetime MS] [wtime MS] [btime MS] [winc MS] [binc MS] [movestogo N]
+//      [infinite] [ponder]           ,    .   
+//                                  "info depth D score cp S nodes N nps N time MS pv <> ...",
+//                                    "bestmove <> [ponder <>]",   "bestmove (none)"
+//   stop                                 
+//   ponderhit                         :    
+//                                      go
+//   quit
+//   go   ,  ,  ,  - Level (  BlackBotLevel),   
+//  ponder.  infinite  ponder bestmove    stop  ponderhit.   nps -
+//   . score cp = 100 * ln( ): 0 - ,   2072.
+//   go  info -   (  -  ), Level -   : Level + 1 
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include "../Game/Config.h"
+#include "../Game/Logic.h"
+#include "../Game/Pdn.h"
+
+//   go
+struct go_params
+{
+    int depth = 0;          // 0 -  
+    size_t nodes = 0;       // 0 -  
+    int move_time = 0;      //   , 0 -  
+    int time_left[2] = {-1, -1}; //     , -1 -  
+    int increment[2] = {0, 0};
+    int moves_to_go = 0;
+    bool infinite = false;
+    bool ponder = false;
+};
+
+//   Bot,      uci:      UCI
+const pair<const char*, const char*> engine_options[] = {
+    {"BotScoringType", "combo var NumberOnly var NumberAndPotential var Weighted var Nnue"},
+    {"Optimization", "combo var O0 var O1 var O2"},
+    {"HashSizeMB", "spin min 0 max 65536"},
+    {"Threads", "spin min 0 max 256"},
+    {"NoRandom", "check"},
+    {"WeightsPath", "string"},
+    {"NnuePath", "string"},
+    {"TablebasePath", "string"},
+    {"BookPath", "string"},
+};
+
+class Engine
+{
+  public:
+    explicit Engine(const Config& base) : config(base)
+    {
+        level = config("Bot", "BlackBotLevel");
+        //      go,     go ponder
+        config.set("Bot", "MoveTimeMS", 0);
+        config.set("Bot", "Ponder", false);
+    }
+
+    ~Engine()
+    {
+        stop();
+    }
+
+    //     , false -  quit
+    bool command(const string& line)
+    {
+        stringstream ss(line);
+        string cmd;
+        if (!(ss >> cmd))
+            return true;
+        if (cmd == "uci")
+        {
+            string text = "id name Checkers\nid author Checkers developers\n";
+            text += "option name Level type spin default " + to_string(level) + " min 1 max " + to_string(MAX_DEPTH) +
+                    "\n";
+            for (const auto& option : engine_options)
+            {
+                const json value = config("Bot", option.first);
+                string shown = value.is_string() ? value.get<string>() : value.dump();
+                if (shown.empty())
+                    shown = "<empty>";
+                text += string("option name ") + option.first + " type " + option.second + " default " + shown + "\n";
+            }
+            say(text + "uciok");
+        }
+        else if (cmd == "isready")
+            say("readyok");
+        else if (cmd == "setoption")
+            set_option(ss);
+        else if (cmd == "ucinewgame")
+        {
+            stop();
+            logic.reset(); //   
+        }
+        else if (cmd == "position")
+        {
+            stop();
+            set_position(ss);
+        }
+        else if (cmd == "go")
+        {
+            stop();
+            go(ss);
+        }
+        else if (cmd == "stop")
+            stop();
+        else if (cmd == "ponderhit")
+            ponderhit();
+        else if (cmd == "quit")
+            return false;
+        else
+            say("info string unknown command " + cmd);
+        return true;
+    }
+
+  private:
+    static constexpr int MAX_DEPTH = 64; //     
+
+    //      :     ,   
+    void say(const string& text)
+    {
+        lock_guard<mutex> lock(output_mutex);
+        cout << text << endl;
+    }
+
+    //      :     Logic
+    Logic& get_logic()
+    {
+        if (!logic)
+        {
+            logic = make_unique<Logic>(&config);
+            logic->set_stop_flag(&stop_flag);
+            logic->set_progress([this](const search_info& info) { report(info); });
+        }
+        return *logic;
+    }
+
+    void set_option(stringstream& ss)
+    {
+        string word, name, value;
+        ss >> word;
+        while (ss >> word && word != "value")
+            name += (name.empty() ? "" : " ") + word;
+        getline(ss >> ws, value);
+        if (value == "<empty>")
+            value.clear();
+        stop();
+        const json parsed = Config::parse_value(value);
+        if (name == "Level")
+        {
+            if (parsed.is_number_integer())
+                level = max(1, min(int(parsed), int(MAX_DEPTH)));
+            return;
+        }
+        if (name == "Ponder")
+            return; //     go ponder
+        config.set("Bot", name, parsed);
+        logic.reset();
+    }
+
+    void set_position(stringstream& ss)
+    {
+        string word;
+        ss >> word;
+        Position pos = Position::start();
+        bool pos_color = false;
+        if (word == "fen")
+        {
+            string fen;
+            while (ss >> word && word != "moves")
+                fen += word;
+            if (!Position::from_fen(fen, pos, pos_color))
+            {
+                say("info string bad FEN " + fen);
+                return;
+            }
+        }
+        else if (word == "startpos")
+            ss >> word;
+        else
+        {
+            say("info string bad position command");
+            return;
+        }
+        position = pos;
+        color = pos_color;
+        if (word != "moves")
+            return;
+
+        //     ,    PDN
+        pdn_game game;
+        game.tags.emplace_back("FEN", pos.to_fen(pos_color));
+        while (ss >> word)
+        {
+            pdn_move m;
+            if (!Pdn_reader::parse_move(word, 0, m))
+            {
+                say("info string bad move " + word);
+                break;
+            }
+            game.moves.push_back(m);
+        }
+        Pdn_replay replay(get_logic());
+        string error;
+        if (!replay.replay(game, nullptr, error))
+            say("info string " + error);
+        position = replay.position();
+        color = replay.turn_color();
+    }
+
+    void go(stringstream& ss)
+    {
+        go_params params;
+        string word;
+        while (ss >> word)
+        {
+            long long value = 0;
+            const bool has_value = word != "infinite" && word != "ponder" && bool(ss >> value);
+            if (word == "depth" && has_value)
+                params.depth = max(1, min(int(value), int(MAX_DEPTH)));
+            else if (word == "nodes" && has_value)
+                params.nodes = size_t(max(0LL, value));
+            else if (word == "movetime" && has_value)
+                params.move_time = int(max(1LL, value));
+            else if (word == "wtime" && has_value)
+                params.time_left[0] = int(max(0LL, value));
+            else if (word == "btime" && has_value)
+                params.time_left[1] = int(max(0LL, value));
+            else if (word == "winc" && has_value)
+                params.increment[0] = int(max(0LL, value));
+            else if (word == "binc" && has_value)
+                params.increment[1] = int(max(0LL, value));
+            else if (word == "movestogo" && has_value)
+                params.moves_to_go = int(max(0LL, value));
+            else if (word == "infinite")
+                params.infinite = true;
+            else if (word == "ponder")
+                params.ponder = true;
+            else
+            {
+                say("info string bad go parameter " + word);
+                ss.clear();
+            }
+        }
+
+        //   :        
+        int budget = params.move_time;
+        if (!budget && params.time_left[color] >= 0)
+        {
+            const int left = params.time_left[color];
+            const int moves = params.moves_to_go ? params.moves_to_go : 30;
+            budget = max(1, min(left / moves + params.increment[color] * 3 / 4, left - 50));
+        }
+
+        Logic& search = get_logic();
+        search.set_position(position);
+        //        Level,   ponderhit   
+        search.Max_depth = params.depth ? params.depth - 1 : (budget || params.nodes || params.infinite ? MAX_DEPTH : level);
+        search.set_node_limit(params.nodes);
+        search.set_move_time(params.ponder || params.infinite ? 0 : budget); //    
+        stop_flag = false;
+        hold = params.infinite || params.ponder;
+        ponder_budget = params.ponder ? budget : 0;
+        last_pv.clear();
+        worker = thread(&Engine::run, this, color);
+    }
+
+    //  :  ,        
+    void run(const bool side)
+    {
+        vector<move_pos> best;
+        logic->find_turns(side);
+        if (!logic->turns.empty())
+            best = logic->find_best_turns(side);
+        {
+            unique_lock<mutex> lock(state_mutex);
+            released.wait(lock, [this] { return !hold; });
+        }
+        if (best.empty())
+        {
+            say("bestmove (none)");
+            return;
+        }
+        string text = "bestmove " + pdn_move_text(best);
+        if (last_pv.size() > 1 && last_pv[0] == best)
+            text += " ponder " + pdn_move_text(last_pv[1]);
+        say(text);
+    }
+
+    //    ,    
+    void report(const search_info& info)
+    {
+        last_pv = info.pv;
+        const long long score = llround(100 * log(max(info.score, 1e-12)));
+        const long long nps = info.ms > 0 ? llround(info.nodes * 1000.0 / info.ms) : 0;
+        string text = "info depth " + to_string(info.depth + 1) + " score cp " + to_string(score) + " nodes " +
+                      to_string(info.nodes) + " nps " + to_string(nps) + " time " + to_string(llround(info.ms)) +
+                      " pv";
+        for (const auto& turns : info.pv)
+            text += " " + pdn_move_text(turns);
+        say(text);
+    }
+
+    //   :          go ponder
+    void ponderhit()
+    {
+        if (!worker.joinable())
+            return;
+        if (ponder_budget)
+        {
+            cancel_timer();
+            timer_cancel = false;
+            const auto deadline = chrono::steady_clock::now() + chrono::milliseconds(ponder_budget);
+            timer = thread([this, deadline]() {
+                unique_lock<mutex> lock(state_mutex);
+                if (!timer_done.wait_until(lock, deadline, [this] { return timer_cancel; }))
+                    stop_flag = true;
+            });
+        }
+        release();
+    }
+
+    //    :      
+    void stop()
+    {
+        if (!worker.joinable())
+            return;
+        stop_flag = true;
+        release();
+        worker.join();
+        cancel_timer();
+    }
+
+    void release()
+    {
+        lock_guard<mutex> lock(state_mutex);
+        hold = false;
+        released.notify_all();
+    }
+
+    void cancel_timer()
+    {
+        if (!timer.joinable())
+            return;
+        {
+            lock_guard<mutex> lock(state_mutex);
+            timer_cancel = true;
+            timer_done.notify_all();
+        }
+        timer.join();
+    }
+
+    Config config;
+    int level = 1;          //   
+    unique_ptr<Logic> logic; // nullptr -   
+    Position position = Position::start();
+    bool color = false;     //    position
+    thread worker;          //  
+    thread timer;           // ,      ponderhit
+    atomic<bool> stop_flag{false};
+    mutex output_mutex;
+    mutex state_mutex;
+    condition_variable released, timer_done;
+    bool hold = false;         //     stop  ponderhit,  state_mutex
+    bool timer_cancel = false; //  state_mutex
+    int ponder_budget = 0;     //     ponderhit, 0 -  
+    vector<vector<move_pos>> last_pv; //   ,   
+};
+
+int main(int argc, char* argv[])
+{
+    Config config;
+    for (int i = 1; i < argc; ++i)
+    {
+        const string arg = argv[i];
+        const size_t eq = arg.find('=');
+        if (eq == string::npos)
+        {
+            cerr << "usage: engine [key=value ...]\n";
+            return 2;
+        }
+        const string name = arg.substr(0, eq);
+        config.set_parsed("Bot", name == "Level" ? "BlackBotLevel" : name, arg.substr(eq + 1));
+    }
+    Engine engine(config);
+    string line;
+    while (getline(cin, line) && engine.command(line))
+        ;
+    return 0;
+}
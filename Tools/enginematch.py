@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+# Матч двух движков с текстовым протоколом Tools/engine.cpp на часах: каждый движок - отдельный процесс,
+# ходы передаются командами position startpos moves ... и go wtime/btime/winc/binc. Партии идут парами
+# с разменом цветов. Ход, который не принял движок соперника ("info string" в ответ на position),
+# и падение флага заканчивают партию проигрышем нарушителя, такие партии выводятся отдельно
+# Использование: enginematch.py [-a "команда"] [-b "команда"] [-games N] [-time MS] [-inc MS] [-plies N]
+#   -a, -b    команда запуска движка с ключами Bot, например "./engine Level=7 HashSizeMB=16"
+#             (по умолчанию "./engine" и "./engine BotScoringType=NumberOnly")
+#   -games N  число партий (по умолчанию 2)
+#   -time MS  время на партию каждому движку, -inc MS - добавка за ход (по умолчанию 2000 и 20)
+#   -plies N  партия без результата после N полуходов - ничья (по умолчанию 160)
+# Итог: победы/ничьи/поражения движка A, нарушения протокола и падения флага
+import argparse
+import queue
+import shlex
+import subprocess
+import sys
+import threading
+import time
+
+
+class Engine:
+    def __init__(self, command):
+        self.proc = subprocess.Popen(shlex.split(command), stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                                     text=True, bufsize=1)
+        self.lines = queue.Queue()
+        threading.Thread(target=self.read, daemon=True).start()
+
+    # Строки ответа читаются отдельным потоком, чтобы ожидание можно было ограничить по времени
+    def read(self):
+        for line in self.proc.stdout:
+            self.lines.put(line.rstrip('\n'))
+        self.lines.put(None)
+
+    def send(self, text):
+        self.proc.stdin.write(text + '\n')
+        self.proc.stdin.flush()
+
+    # Ожидание строки, которая начинается с prefix; возвращает её и все строки до неё
+    def wait(self, prefix, timeout):
+        lines = []
+        end = time.time() + timeout
+        while True:
+            line = self.lines.get(timeout=max(0.01, end - time.time()))
+            if line is None:
+                raise RuntimeError('engine exited')
+            lines.append(line)
+            if line.startswith(prefix):
+                return line, lines
+
+    def quit(self):
+        self.send('quit')
+        self.proc.wait()
+
+
+# Партия: engines[0] играет белыми. Возвращает очки белых (1, 0.5, 0), причину и число полуходов
+def play(engines, args):
+    moves = []
+    clock = [args.time, args.time]
+    for engine in engines:
+        engine.send('ucinewgame')
+        engine.send('isready')
+        engine.wait('readyok', 30)
+    for ply in range(args.plies):
+        side = ply % 2
+        engine = engines[side]
+        engine.send('position startpos' + (' moves ' + ' '.join(moves) if moves else ''))
+        start = time.time()
+        engine.send('go wtime %d btime %d winc %d binc %d' % (clock[0], clock[1], args.inc, args.inc))
+        line, lines = engine.wait('bestmove', clock[side] / 1000 + 30)
+        clock[side] -= int((time.time() - start) * 1000) - args.inc
+        lost = 0 if side == 0 else 1
+        if any(text.startswith('info string') for text in lines):
+            return lost, 'illegal ' + moves[-1] if moves else 'bad position', ply
+        if clock[side] < 0:
+            return lost, 'flag', ply
+        move = line.split()[1]
+        if move == '(none)':
+            return lost, 'no moves', ply
+        moves.append(move)
+    return 0.5, 'max plies', args.plies
+
+
+def main():
+    parser = argparse.ArgumentParser(description='match of two text-protocol engines')
+    parser.add_argument('-a', default='./engine')
+    parser.add_argument('-b', default='./engine BotScoringType=NumberOnly')
+    parser.add_argument('-games', type=int, default=2)
+    parser.add_argument('-time', type=int, default=2000)
+    parser.add_argument('-inc', type=int, default=20)
+    parser.add_argument('-plies', type=int, default=160)
+    args = parser.parse_args()
+
+    a, b = Engine(args.a), Engine(args.b)
+    for engine in (a, b):
+        engine.send('uci')
+        engine.wait('uciok', 30)
+    wins = draws = losses = errors = flags = 0
+    for game in range(args.games):
+        a_white = game % 2 == 0
+        white_score, reason, plies = play([a, b] if a_white else [b, a], args)
+        score = white_score if a_white else 1 - white_score
+        wins += score == 1
+        draws += score == 0.5
+        losses += score == 0
+        errors += reason.startswith('illegal') or reason == 'bad position'
+        flags += reason == 'flag'
+        print('game %d: A %s, %s %s after %d plies' % (game + 1, 'white' if a_white else 'black',
+                                                      {1: 'wins', 0.5: 'draws', 0: 'loses'}[score], reason, plies))
+        sys.stdout.flush()
+    for engine in (a, b):
+        engine.quit()
+    print('A: %d wins, %d draws, %d losses; %d protocol errors, %d flags' % (wins, draws, losses, errors, flags))
+    return 1 if errors else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,317 @@
+//     "Nnue" (Game/Nnue.h)    
+// : nnuetrain <> [ ] [-epochs N] [-lr L] [-seed S]
+//      -   "FEN ",   Tools/tournament.cpp  -record
+//     -    (  network.nnue),   Logic  NnuePath
+//   -epochs N -     (  20), -lr L -  Adam (  0.001)
+//             sigmoid(),
+//  Tools/tune.cpp,        NNUE_QA  NNUE_QB. 10% 
+//   :      ,   
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "../Game/Config.h"
+#include "../Game/Logic.h"
+
+//    :       
+struct net_sample
+{
+    uint8_t count;
+    uint8_t features[24];
+    float result; //    
+};
+
+//   ,    ,   Tools/tune.cpp
+bool load_samples(const string& path, Logic& logic, vector<net_sample>& samples, size_t& skipped)
+{
+    ifstream fin(path);
+    if (!fin)
+        return false;
+    string line, fen;
+    float result;
+    skipped = 0;
+    while (getline(fin, line))
+    {
+        istringstream ss(line);
+        Position pos;
+        bool color;
+        if (!(ss >> fen >> result) || !Position::from_fen(fen, pos, color) || !pos.pieces(false) ||
+            !pos.pieces(true) || pop_count(pos.occupied()) > 24)
+        {
+            ++skipped;
+            continue;
+        }
+        logic.set_position(pos);
+        logic.find_turns(color);
+        if (logic.have_beats)
+        {
+            ++skipped;
+            continue;
+        }
+        net_sample s;
+        s.count = 0;
+        for (BB_T b = pos.occupied(); b; b &= b - 1)
+        {
+            const int sq = low_bit(b);
+            s.features[s.count++] = uint8_t(nnue_feature(pos.get(sq), sq));
+        }
+        s.result = result;
+        samples.push_back(s);
+    }
+    return true;
+}
+
+//      
+struct float_net
+{
+    float ft_weights[NNUE_INPUTS][NNUE_HIDDEN];
+    float ft_bias[NNUE_HIDDEN];
+    float out_weights[NNUE_HIDDEN];
+    float out_bias;
+};
+
+//  ,      :   24 
+//   int16,   -  int8
+const float MAX_FT_WEIGHT = 32767.0f / (25 * NNUE_QA);
+const float MAX_OUT_WEIGHT = 127.0f / NNUE_QB;
+
+//  :       pre,   
+float forward(const float_net& net, const net_sample& s, float* pre)
+{
+    for (int i = 0; i < NNUE_HIDDEN; ++i)
+        pre[i] = net.ft_bias[i];
+    for (int f = 0; f < s.count; ++f)
+    {
+        const float* w = net.ft_weights[s.features[f]];
+        for (int i = 0; i < NNUE_HIDDEN; ++i)
+            pre[i] += w[i];
+    }
+    float z = net.out_bias;
+    for (int i = 0; i < NNUE_HIDDEN; ++i)
+        z += min(max(pre[i], 0.0f), 1.0f) * net.out_weights[i];
+    return z;
+}
+
+float sigmoid(const float z)
+{
+    return 1 / (1 + exp(-z));
+}
+
+//       [from, to)
+double calc_error(const float_net& net, const vector<net_sample>& samples, const size_t from, const size_t to)
+{
+    float pre[NNUE_HIDDEN];
+    double sum = 0;
+    for (size_t i = from; i < to; ++i)
+    {
+        const double d = sigmoid(forward(net, samples[i], pre)) - samples[i].result;
+        sum += d * d;
+    }
+    return to > from ? sum / (to - from) : 0;
+}
+
+//      ,   ,    
+double calc_error(const Nnue_network& net, const vector<net_sample>& samples, const size_t from, const size_t to)
+{
+    double sum = 0;
+    for (size_t i = from; i < to; ++i)
+    {
+        Position pos;
+        const net_sample& s = samples[i];
+        for (int f = 0; f < s.count; ++f)
+        {
+            const int type = s.features[f] / 32 + 1, sq = s.features[f] % 32;
+            pos.put_piece(sq, POS_T(type));
+        }
+        Nnue_accumulator acc;
+        net.refresh(pos, acc);
+        const double d = 1 / (1 + exp(-net.logit(acc))) - s.result;
+        sum += d * d;
+    }
+    return to > from ? sum / (to - from) : 0;
+}
+
+//  Adam:     
+struct adam
+{
+    vector<float> m, v;
+    float b1t = 1, b2t = 1;
+
+    explicit adam(const size_t n) : m(n, 0), v(n, 0)
+    {
+    }
+
+    //    grad   params     limit[i]
+    void step(float* params, const float* grad, const float* limit, const float lr)
+    {
+        const float b1 = 0.9f, b2 = 0.999f, eps = 1e-8f;
+        b1t *= b1;
+        b2t *= b2;
+        for (size_t i = 0; i < m.size(); ++i)
+        {
+            m[i] = b1 * m[i] + (1 - b1) * grad[i];
+            v[i] = b2 * v[i] + (1 - b2) * grad[i] * grad[i];
+            const float p = params[i] - lr * (m[i] / (1 - b1t)) / (sqrt(v[i] / (1 - b2t)) + eps);
+            params[i] = min(max(p, -limit[i]), limit[i]);
+        }
+    }
+};
+
+//     Game/Nnue.h   
+bool save_network(const string& path, const float_net& net)
+{
+    ofstream fout(path, ios::binary);
+    nnue_header header;
+    memcpy(header.magic, "CKNN", 4);
+    header.version = NNUE_VERSION;
+    header.inputs = NNUE_INPUTS;
+    header.hidden = NNUE_HIDDEN;
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    auto write16 = [&](const float value, const int scale) {
+        const int16_t q = int16_t(lround(value * scale));
+        fout.write(reinterpret_cast<const char*>(&q), sizeof(q));
+    };
+    for (int i = 0; i < NNUE_HIDDEN; ++i)
+        write16(net.ft_bias[i], NNUE_QA);
+    for (int f = 0; f < NNUE_INPUTS; ++f)
+        for (int i = 0; i < NNUE_HIDDEN; ++i)
+            write16(net.ft_weights[f][i], NNUE_QA);
+    for (int i = 0; i < NNUE_HIDDEN; ++i)
+    {
+        const int8_t q = int8_t(lround(net.out_weights[i] * NNUE_QB));
+        fout.write(reinterpret_cast<const char*>(&q), sizeof(q));
+    }
+    const int32_t bias = int32_t(lround(double(net.out_bias) * NNUE_QA * NNUE_QB));
+    fout.write(reinterpret_cast<const char*>(&bias), sizeof(bias));
+    return bool(fout);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: nnuetrain <positions> [network file] [-epochs N] [-lr L] [-seed S]\n";
+        return 2;
+    }
+    const string positions_path = argv[1];
+    string network_path = "network.nnue";
+    int epochs = 20;
+    float lr = 0.001f;
+    unsigned seed = unsigned(time(0));
+    for (int i = 2; i < argc; ++i)
+    {
+        const string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "-epochs" && has_value)
+            epochs = max(1, atoi(argv[++i]));
+        else if (arg == "-lr" && has_value)
+            lr = float(atof(argv[++i]));
+        else if (arg == "-seed" && has_value)
+            seed = unsigned(atoi(argv[++i]));
+        else
+            network_path = arg;
+    }
+
+    Config config;
+    Logic logic(&config);
+    auto start = chrono::steady_clock::now();
+    vector<net_sample> samples;
+    size_t skipped = 0;
+    if (!load_samples(positions_path, logic, samples, skipped))
+    {
+        cerr << "cannot read " << positions_path << "\n";
+        return 1;
+    }
+    cout << samples.size() << " positions, " << skipped << " skipped" << endl;
+    if (samples.size() < 10)
+        return 1;
+
+    mt19937 rng(seed);
+    shuffle(samples.begin(), samples.end(), rng);
+    const size_t train_size = samples.size() - samples.size() / 10;
+
+    //  :  ,    -    
+    float_net net;
+    uniform_real_distribution<float> init(-0.1f, 0.1f);
+    for (auto& column : net.ft_weights)
+        for (auto& w : column)
+            w = init(rng);
+    for (int i = 0; i < NNUE_HIDDEN; ++i)
+    {
+        net.ft_bias[i] = 0.5f;
+        net.out_weights[i] = init(rng);
+    }
+    net.out_bias = 0;
+
+    //         
+    const size_t params_num = sizeof(float_net) / sizeof(float);
+    float* params = reinterpret_cast<float*>(&net);
+    vector<float> grad_data(params_num), limit_data(params_num);
+    float_net& grad = *reinterpret_cast<float_net*>(grad_data.data());
+    float_net& limit = *reinterpret_cast<float_net*>(limit_data.data());
+    for (auto& column : limit.ft_weights)
+        for (auto& w : column)
+            w = MAX_FT_WEIGHT;
+    for (int i = 0; i < NNUE_HIDDEN; ++i)
+    {
+        limit.ft_bias[i] = MAX_FT_WEIGHT;
+        limit.out_weights[i] = MAX_OUT_WEIGHT;
+    }
+    limit.out_bias = 1e9f;
+    adam opt(params_num);
+
+    const size_t batch_size = 256;
+    float pre[NNUE_HIDDEN];
+    cout << "initial error " << calc_error(net, samples, 0, train_size) << ", validation "
+         << calc_error(net, samples, train_size, samples.size()) << endl;
+    for (int epoch = 1; epoch <= epochs; ++epoch)
+    {
+        shuffle(samples.begin(), samples.begin() + train_size, rng);
+        for (size_t from = 0; from < train_size; from += batch_size)
+        {
+            const size_t to = min(train_size, from + batch_size);
+            fill(grad_data.begin(), grad_data.end(), 0.0f);
+            for (size_t k = from; k < to; ++k)
+            {
+                const net_sample& s = samples[k];
+                const float p = sigmoid(forward(net, s, pre));
+                //      ,   
+                const float dz = 2 * (p - s.result) * p * (1 - p) / float(to - from);
+                grad.out_bias += dz;
+                for (int i = 0; i < NNUE_HIDDEN; ++i)
+                {
+                    grad.out_weights[i] += dz * min(max(pre[i], 0.0f), 1.0f);
+                    if (pre[i] <= 0 || pre[i] >= 1)
+                        continue; //  ,   
+                    const float dh = dz * net.out_weights[i];
+                    grad.ft_bias[i] += dh;
+                    for (int f = 0; f < s.count; ++f)
+                        grad.ft_weights[s.features[f]][i] += dh;
+                }
+            }
+            opt.step(params, grad_data.data(), limit_data.data(), lr);
+        }
+        cout << "epoch " << epoch << ": error " << calc_error(net, samples, 0, train_size) << ", validation "
+             << calc_error(net, samples, train_size, samples.size()) << ", "
+             << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s" << endl;
+    }
+
+    if (!save_network(network_path, net))
+    {
+        cerr << "cannot write " << network_path << "\n";
+        return 1;
+    }
+    //   :         
+    Nnue_network quantized;
+    if (!quantized.load(network_path))
+    {
+        cerr << "cannot read back " << network_path << "\n";
+        return 1;
+    }
+    cout << "Written " << network_path << ", quantized validation error "
+         << calc_error(quantized, samples, train_size, samples.size()) << endl;
+    return 0;
+}
@@ -0,0 +1,89 @@
+//    PDN:       ,  
+//   ,       
+// : pdncheck <.pdn> [-positions <>] [-errors N]
+//   -positions <> -          
+//                       "FEN ",  tournament -record,  Tools/tune.cpp  Tools/nnuetrain.cpp
+//   -errors N         -    (  20)
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "../Game/Config.h"
+#include "../Game/Logic.h"
+#include "../Game/Pdn.h"
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: pdncheck <file.pdn> [-positions <file>] [-errors N]\n";
+        return 2;
+    }
+    const string pdn_path = argv[1];
+    string positions_path;
+    int max_errors = 20;
+    for (int i = 2; i < argc; ++i)
+    {
+        const string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "-positions" && has_value)
+            positions_path = argv[++i];
+        else if (arg == "-errors" && has_value)
+            max_errors = max(0, atoi(argv[++i]));
+    }
+
+    Pdn_reader reader;
+    if (!reader.open(pdn_path))
+    {
+        cerr << "cannot read " << pdn_path << "\n";
+        return 1;
+    }
+    ofstream positions_file;
+    if (!positions_path.empty())
+    {
+        positions_file.open(positions_path, ios_base::app);
+        if (!positions_file)
+        {
+            cerr << "cannot write " << positions_path << "\n";
+            return 1;
+        }
+    }
+
+    Config config;
+    Logic logic(&config);
+    Pdn_replay replay(logic);
+    auto start = chrono::steady_clock::now();
+    pdn_game game;
+    vector<pair<Position, bool>> positions;
+    size_t games = 0, valid = 0, moves = 0, written = 0;
+    int errors = 0;
+    while (reader.next(game))
+    {
+        ++games;
+        string error = game.error;
+        positions.clear();
+        if (error.empty() && replay.replay(game, &positions, error))
+        {
+            ++valid;
+            moves += game.moves.size();
+            const double score = pdn_white_score(game.result);
+            if (positions_file.is_open() && score >= 0)
+            {
+                for (const auto& p : positions)
+                    positions_file << p.first.to_fen(p.second) << ' ' << score << '\n';
+                written += positions.size();
+            }
+            continue;
+        }
+        if (errors++ < max_errors)
+            cout << "game " << games << " (" << game.tag("White") << " - " << game.tag("Black") << "): " << error
+                 << "\n";
+    }
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << games << " games, " << valid << " valid, " << games - valid << " invalid, " << moves << " moves, "
+         << seconds << " s, " << reader.offset() / 1048576.0 / max(seconds, 1e-9) << " MB/s" << endl;
+    if (positions_file.is_open())
+        cout << "Written " << written << " positions to " << positions_path << endl;
+    return valid == games ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+//       Logic::find_turns:     N (perft)
+//     ,    -  
+// : perft                  -      
+//                perft <> [FEN]  -     (  )
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "../Game/Config.h"
+#include "../Game/Logic.h"
+
+//         1, 2, ...
+struct perft_case
+{
+    const char* name;
+    const char* fen;
+    vector<size_t> counts;
+};
+
+//         
+const vector<perft_case> reference_cases = {
+    { "start", "W:W21,22,23,24,25,26,27,28,29,30,31,32:B1,2,3,4,5,6,7,8,9,10,11,12",
+      { 7, 49, 302, 1469, 7482, 37986, 190146, 929984 } },
+    { "capture series", "B:W10,18,19,22,25,26,27,29,30,31,32:B1,2,3,4,5,6,7,8,12,13",
+      { 2, 8, 63, 457, 3493, 24466, 174850, 1172798 } },
+    { "promotion in series", "W:W19,21,22,23,24,25,26,28,29,30,32:B1,2,4,5,7,8,9,12,13,14,15",
+      { 2, 13, 87, 448, 2464, 12000, 66251, 313062 } },
+    { "flying kings", "W:WK29,K4,18,23:BK1,K32,10,14,22",
+      { 2, 3, 11, 75, 554, 5175, 48575 } },
+    { "kings endgame", "B:WK2:B4,K15",
+      { 13, 81, 651, 4564, 36508, 254484, 2028818 } },
+};
+
+size_t perft(Logic& logic, const Position& pos, const bool color, const int depth);
+
+//   turn:         ,   
+//   ,     
+size_t perft_series(Logic& logic, const Position& pos, const move_pos turn, const bool color, const int depth)
+{
+    logic.set_position(pos);
+    logic.make_turn(turn);
+    const Position next = logic.get_position();
+    if (turn.xb != -1)
+    {
+        logic.find_turns(turn.x2, turn.y2);
+        if (logic.have_beats)
+        {
+            const vector<move_pos> turns = logic.turns;
+            size_t res = 0;
+            for (auto next_turn : turns)
+                res += perft_series(logic, next, next_turn, color, depth);
+            return res;
+        }
+    }
+    return perft(logic, next, !color, depth - 1);
+}
+
+//    depth    pos, color -  
+size_t perft(Logic& logic, const Position& pos, const bool color, const int depth)
+{
+    if (depth == 0)
+        return 1;
+    logic.set_position(pos);
+    logic.find_turns(color);
+    const vector<move_pos> turns = logic.turns;
+    size_t res = 0;
+    for (auto turn : turns)
+        res += perft_series(logic, pos, turn, color, depth);
+    return res;
+}
+
+//      ,   
+size_t run(Logic& logic, const Position& pos, const bool color, const int depth, double& ms)
+{
+    auto start = chrono::steady_clock::now();
+    const size_t res = perft(logic, pos, color, depth);
+    ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    return res;
+}
+
+int main(int argc, char* argv[])
+{
+    Config config;
+    Logic logic(&config);
+    Position pos;
+    bool color = false;
+
+    if (argc > 1)
+    {
+        const int depth = atoi(argv[1]);
+        const string fen = argc > 2 ? argv[2] : reference_cases[0].fen;
+        if (!Position::from_fen(fen, pos, color))
+        {
+            cerr << "Bad FEN: " << fen << "\n";
+            return 2;
+        }
+        for (int d = 1; d <= depth; ++d)
+        {
+            double ms;
+            const size_t res = run(logic, pos, color, d, ms);
+            cout << "depth " << d << ": " << res << " positions, " << ms << " ms, "
+                 << (ms > 0 ? size_t(res / ms * 1000) : 0) << " positions/sec\n";
+        }
+        return 0;
+    }
+
+    //   
+    bool all_ok = true;
+    size_t total = 0;
+    double total_ms = 0;
+    for (const auto& test : reference_cases)
+    {
+        Position::from_fen(test.fen, pos, color);
+        for (size_t d = 1; d <= test.counts.size(); ++d)
+        {
+            double ms;
+            const size_t res = run(logic, pos, color, int(d), ms);
+            const bool ok = res == test.counts[d - 1];
+            all_ok &= ok;
+            total += res;
+            total_ms += ms;
+            cout << test.name << ", depth " << d << ": " << res << (ok ? " OK" : " FAIL, expected ")
+                 << (ok ? string() : to_string(test.counts[d - 1])) << "\n";
+        }
+    }
+    cout << (all_ok ? "All OK" : "Some FAILED") << ", " << total << " positions, " << total_ms << " ms, "
+         << (total_ms > 0 ? size_t(total / total_ms * 1000) : 0) << " positions/sec\n";
+    return all_ok ? 0 : 1;
+}
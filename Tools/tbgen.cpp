@@ -0,0 +1,275 @@
+//     Game/Tablebase.h  
+// : tbgen [] [] -         (  4)
+//                                        (  endgame.cdb)
+//        ,    -    ,
+//             
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+
+#include "../Game/Config.h"
+#include "../Game/Logic.h"
+#include "../Game/Tablebase.h"
+
+//       
+int material_key(const tb_material& m)
+{
+    return ((m.men[0] * 8 + m.kings[0]) * 8 + m.men[1]) * 8 + m.kings[1];
+}
+
+//      color   pos:     
+void collect_series(Logic& logic, const Position& pos, const move_pos turn, vector<Position>& res)
+{
+    logic.set_position(pos);
+    logic.make_turn(turn);
+    const Position next = logic.get_position();
+    if (turn.xb != -1)
+    {
+        logic.find_turns(turn.x2, turn.y2);
+        if (logic.have_beats)
+        {
+            const vector<move_pos> turns = logic.turns;
+            for (auto next_turn : turns)
+                collect_series(logic, next, next_turn, res);
+            return;
+        }
+    }
+    res.push_back(next);
+}
+
+void collect_successors(Logic& logic, const Position& pos, const bool color, vector<Position>& res)
+{
+    res.clear();
+    logic.set_position(pos);
+    logic.find_turns(color);
+    const vector<move_pos> turns = logic.turns;
+    for (auto turn : turns)
+        collect_series(logic, pos, turn, res);
+}
+
+//        :    
+bool is_valid(const Position& pos)
+{
+    const BB_T men = ~pos.kings;
+    return !(pos.white & men & 0x0000000Fu) && !(pos.black & men & 0xF0000000u);
+}
+
+//   .          built
+vector<uint8_t> build_table(Logic& logic, const tb_material& m, const map<int, vector<uint8_t>>& built)
+{
+    const uint32_t n = uint32_t(tb_size(m));
+    const uint16_t NO_WIN = 0xFFFF;
+    vector<uint8_t> pending(n, 0);          //    ,     
+    vector<uint16_t> longest(n, 0);         //       
+    vector<uint8_t> can_lose(n, 0);         //         
+    vector<uint8_t> resolved(n, 0);
+    vector<uint32_t> succ_start(n + 1, 0);  //   
+    vector<uint32_t> succ;
+    vector<vector<uint32_t>> buckets(2);    // -      
+
+    auto push = [&](const int plies, const uint32_t idx) {
+        if (size_t(plies) >= buckets.size())
+            buckets.resize(plies + 1);
+        buckets[plies].push_back(idx);
+    };
+
+    vector<Position> next;
+    for (uint32_t idx = 0; idx < n; ++idx)
+    {
+        succ_start[idx] = uint32_t(succ.size());
+        bool color;
+        const Position pos = tb_position(m, idx, color);
+        if (!is_valid(pos))
+            continue; //    
+        collect_successors(logic, pos, color, next);
+        if (next.empty())
+        {
+            push(0, idx); //   - 
+            continue;
+        }
+        uint16_t best_win = NO_WIN;
+        bool lose = true;
+        uint16_t max_loss = 0;
+        uint32_t inside = 0;
+        for (const auto& q : next)
+        {
+            const tb_material mq(q);
+            if (mq == m)
+            {
+                succ.push_back(uint32_t(tb_index(q, !color)));
+                ++inside;
+                continue;
+            }
+            if (!q.pieces(!color))
+            {
+                best_win = 1; //     
+                lose = false;
+                continue;
+            }
+            int plies;
+            const tb_outcome outcome = tb_decode(built.at(material_key(mq))[tb_index(q, !color)], plies);
+            if (outcome == tb_outcome::LOSS)
+            {
+                best_win = min<uint16_t>(best_win, uint16_t(plies + 1));
+                lose = false;
+            }
+            else if (outcome == tb_outcome::WIN)
+                max_loss = max<uint16_t>(max_loss, uint16_t(plies + 1));
+            else
+                lose = false;
+        }
+        if (best_win != NO_WIN)
+            push(best_win, idx);
+        pending[idx] = uint8_t(inside);
+        longest[idx] = max_loss;
+        can_lose[idx] = lose;
+        if (lose && !inside)
+            push(max_loss, idx);
+    }
+    succ_start[n] = uint32_t(succ.size());
+
+    //  :    -  ,      
+    vector<uint32_t> pred_start(n + 1, 0), pred(succ.size());
+    for (auto s : succ)
+        ++pred_start[s + 1];
+    for (uint32_t i = 0; i < n; ++i)
+        pred_start[i + 1] += pred_start[i];
+    {
+        vector<uint32_t> fill(pred_start.begin(), pred_start.end() - 1);
+        for (uint32_t idx = 0; idx < n; ++idx)
+            for (uint32_t e = succ_start[idx]; e < succ_start[idx + 1]; ++e)
+                pred[fill[succ[e]]++] = idx;
+    }
+    vector<uint32_t>().swap(succ);
+    vector<uint32_t>().swap(succ_start);
+
+    //          :   L 
+    //     L + 1,  -     
+    vector<uint8_t> values(n, 0);
+    for (size_t plies = 0; plies < buckets.size(); ++plies)
+    {
+        for (size_t i = 0; i < buckets[plies].size(); ++i)
+        {
+            const uint32_t idx = buckets[plies][i];
+            if (resolved[idx])
+                continue;
+            resolved[idx] = 1;
+            const bool win = plies % 2;
+            values[idx] = tb_encode(win ? tb_outcome::WIN : tb_outcome::LOSS, int(plies));
+            for (uint32_t e = pred_start[idx]; e < pred_start[idx + 1]; ++e)
+            {
+                const uint32_t p = pred[e];
+                if (resolved[p])
+                    continue;
+                if (!win)
+                    push(int(plies) + 1, p);
+                else
+                {
+                    longest[p] = max<uint16_t>(longest[p], uint16_t(plies + 1));
+                    if (--pending[p] == 0 && can_lose[p])
+                        push(longest[p], p);
+                }
+            }
+        }
+        vector<uint32_t>().swap(buckets[plies]);
+    }
+    return values;
+}
+
+int main(int argc, char* argv[])
+{
+    const int max_pieces = argc > 1 ? atoi(argv[1]) : 4;
+    const string path = argc > 2 ? argv[2] : "endgame.cdb";
+    if (max_pieces < 2 || max_pieces > TB_MAX_PIECES)
+    {
+        cerr << "pieces must be from 2 to " << TB_MAX_PIECES << "\n";
+        return 2;
+    }
+
+    //  ,        
+    vector<tb_material> order;
+    for (int wm = 0; wm <= max_pieces; ++wm)
+        for (int wk = 0; wm + wk <= max_pieces; ++wk)
+            for (int bm = 0; wm + wk + bm <= max_pieces; ++bm)
+                for (int bk = 0; wm + wk + bm + bk <= max_pieces; ++bk)
+                {
+                    tb_material m;
+                    m.men[0] = wm, m.kings[0] = wk, m.men[1] = bm, m.kings[1] = bk;
+                    if (wm + wk && bm + bk)
+                        order.push_back(m);
+                }
+    stable_sort(order.begin(), order.end(), [](const tb_material& a, const tb_material& b) {
+        if (a.pieces() != b.pieces())
+            return a.pieces() < b.pieces();
+        return a.men[0] + a.men[1] < b.men[0] + b.men[1];
+    });
+
+    Config config;
+    Logic logic(&config);
+    map<int, vector<uint8_t>> built;
+    auto start = chrono::steady_clock::now();
+    for (const auto& m : order)
+    {
+        auto table_start = chrono::steady_clock::now();
+        vector<uint8_t> values = build_table(logic, m, built);
+        size_t wins = 0, losses = 0;
+        for (auto v : values)
+        {
+            int plies;
+            const tb_outcome outcome = tb_decode(v, plies);
+            wins += outcome == tb_outcome::WIN;
+            losses += outcome == tb_outcome::LOSS;
+        }
+        cout << "W" << m.men[0] << "K" << m.kings[0] << " B" << m.men[1] << "K" << m.kings[1] << ": "
+             << values.size() << " positions, " << wins << " wins, " << losses << " losses, "
+             << chrono::duration<double>(chrono::steady_clock::now() - table_start).count() << " s" << endl;
+        built[material_key(m)] = move(values);
+    }
+
+    //  : ,  , 
+    FILE* fout = fopen(path.c_str(), "wb");
+    if (!fout)
+    {
+        cerr << "cannot write " << path << "\n";
+        return 1;
+    }
+    tb_header header;
+    memcpy(header.magic, "CKTB", 4);
+    header.version = TB_VERSION;
+    header.max_pieces = uint32_t(max_pieces);
+    header.tables = uint32_t(order.size());
+    fwrite(&header, sizeof(header), 1, fout);
+    uint64_t offset = sizeof(tb_header) + order.size() * sizeof(tb_table_info);
+    for (const auto& m : order)
+    {
+        tb_table_info info;
+        memset(&info, 0, sizeof(info));
+        for (int c = 0; c < 2; ++c)
+        {
+            info.men[c] = uint8_t(m.men[c]);
+            info.kings[c] = uint8_t(m.kings[c]);
+        }
+        info.offset = offset;
+        info.count = tb_size(m);
+        offset += info.count;
+        fwrite(&info, sizeof(info), 1, fout);
+    }
+    for (const auto& m : order)
+    {
+        const vector<uint8_t>& values = built[material_key(m)];
+        fwrite(values.data(), 1, values.size(), fout);
+    }
+    const bool ok = !ferror(fout);
+    fclose(fout);
+    if (!ok)
+    {
+        cerr << "cannot write " << path << "\n";
+        return 1;
+    }
+    cout << "Written " << path << ", " << offset << " bytes, "
+         << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s" << endl;
+    return 0;
+}
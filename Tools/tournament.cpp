@@ -0,0 +1,339 @@
+//      :      ,
+//    //,  Elo   SPRT
+// : tournament []
+//   -a <>    ,  Level=5,BotScoringType=NumberOnly
+//   -b <>    .  -   Bot settings.json, Level -  
+//                   (  BlackBotLevel),   ,      
+//   -games N          (  1000),      
+//                     ,  Elo  SPRT     (0, 1/2, 1, 1 1/2, 2)
+//   -threads N        (    )
+//   -random N          ,     (  4)
+//   -elo0 E -elo1 E  SPRT   Elo   (  0  10)
+//   -alpha A -beta B   SPRT (  0.05)
+//   -stop            ,  SPRT    
+//   -seed S            
+//   -record <>           Tools/tune.cpp:
+//                    "FEN ",  1 -  , 0.5 - , 0 -  
+//    MaxNumTurns   Game,     .     -
+// 16  (      ),     HashSizeMB  -a  -b
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+
+#include "../Game/Config.h"
+#include "../Game/Logic.h"
+
+//   
+struct engine_spec
+{
+    Config config;
+    int level = 0;
+    string text; //    ,     
+};
+
+//    key=value,key=value  settings.json
+bool parse_spec(const string& text, engine_spec& spec)
+{
+    spec.text = text.empty() ? "default" : text;
+    spec.level = spec.config("Bot", "BlackBotLevel");
+    //    ,         .
+    //    settings.json    ,       
+    spec.config.set("Bot", "Threads", 1);
+    spec.config.set("Bot", "MoveTimeMS", 0);
+    spec.config.set("Bot", "HashSizeMB", 16);
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ','))
+    {
+        const size_t eq = item.find('=');
+        if (eq == string::npos)
+            return false;
+        const string name = item.substr(0, eq), value = item.substr(eq + 1);
+        const json parsed = Config::parse_value(value);
+        if (name == "Level")
+        {
+            if (!parsed.is_number_integer())
+                return false;
+            spec.level = parsed;
+        }
+        else
+            spec.config.set("Bot", name, parsed);
+    }
+    return true;
+}
+
+//   
+struct score_table
+{
+    size_t wins = 0, draws = 0, losses = 0;
+    size_t pairs[5] = {}; //           : 0, 1/2, 1, 1 1/2, 2
+
+    size_t games() const
+    {
+        return wins + draws + losses;
+    }
+
+    //    : 1 - , 0.5 - 
+    double score() const
+    {
+        return games() ? (wins + 0.5 * draws) / games() : 0.5;
+    }
+
+    size_t pair_count() const
+    {
+        return pairs[0] + pairs[1] + pairs[2] + pairs[3] + pairs[4];
+    }
+
+    //       
+    double pair_score() const
+    {
+        const size_t n = pair_count();
+        if (!n)
+            return 0.5;
+        double sum = 0;
+        for (int k = 0; k < 5; ++k)
+            sum += pairs[k] * k / 4.0;
+        return sum / n;
+    }
+
+    //     ().       ,
+    //    ,    ,    
+    double pair_variance() const
+    {
+        const size_t n = pair_count();
+        if (!n)
+            return 0;
+        const double s = pair_score();
+        double sum = 0;
+        for (int k = 0; k < 5; ++k)
+            sum += pairs[k] * (k / 4.0 - s) * (k / 4.0 - s);
+        return sum / n;
+    }
+};
+
+//  Elo,    s
+double elo_from_score(double s)
+{
+    s = min(max(s, 1e-6), 1 - 1e-6);
+    return -400 * log10(1 / s - 1);
+}
+
+double score_from_elo(const double elo)
+{
+    return 1 / (1 + pow(10, -elo / 400));
+}
+
+//     elo1  elo0      
+double sprt_llr(const score_table& t, const double elo0, const double elo1)
+{
+    const double var = t.pair_variance();
+    if (var <= 0)
+        return 0;
+    const double s0 = score_from_elo(elo0), s1 = score_from_elo(elo1);
+    return t.pair_count() * (s1 - s0) * (2 * t.pair_score() - s0 - s1) / (2 * var);
+}
+
+//    plies , false -    
+bool random_opening(Logic& logic, const int plies, mt19937& rng, Position& pos)
+{
+    logic.set_position(Position::start());
+    for (int turn_num = 0; turn_num < plies; ++turn_num)
+    {
+        logic.find_turns(turn_num % 2);
+        if (logic.turns.empty())
+            return false;
+        //  ,      
+        while (true)
+        {
+            const move_pos turn = logic.turns[rng() % logic.turns.size()];
+            logic.make_turn(turn);
+            if (turn.xb == -1)
+                break;
+            logic.find_turns(turn.x2, turn.y2);
+            if (!logic.have_beats)
+                break;
+        }
+    }
+    logic.find_turns(plies % 2);
+    if (logic.turns.empty())
+        return false;
+    pos = logic.get_position();
+    return true;
+}
+
+//    pos, first_turn -    ( -  )
+//  1 -  , -1 -  , 0 - .     record
+int play_game(Logic& white, Logic& black, Position pos, const int first_turn, const int max_turns,
+              vector<string>& record)
+{
+    for (int turn_num = first_turn; turn_num < max_turns; ++turn_num)
+    {
+        const bool color = turn_num % 2;
+        Logic& logic = color ? black : white;
+        logic.set_position(pos);
+        logic.find_turns(color);
+        if (logic.turns.empty())
+            return color ? 1 : -1; //   - 
+        record.push_back(pos.to_fen(color));
+        for (auto turn : logic.find_best_turns(color))
+            logic.make_turn(turn);
+        pos = logic.get_position();
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    int games = 1000, threads_num = max(1, int(thread::hardware_concurrency())), random_plies = 4;
+    double elo0 = 0, elo1 = 10, alpha = 0.05, beta = 0.05;
+    bool stop_on_verdict = false;
+    unsigned seed = unsigned(time(0));
+    string record_path;
+    engine_spec engines[2];
+    string spec_text[2];
+    for (int i = 1; i < argc; ++i)
+    {
+        const string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "-a" && has_value)
+            spec_text[0] = argv[++i];
+        else if (arg == "-b" && has_value)
+            spec_text[1] = argv[++i];
+        else if (arg == "-games" && has_value)
+            games = atoi(argv[++i]);
+        else if (arg == "-threads" && has_value)
+            threads_num = max(1, atoi(argv[++i]));
+        else if (arg == "-random" && has_value)
+            random_plies = atoi(argv[++i]);
+        else if (arg == "-elo0" && has_value)
+            elo0 = atof(argv[++i]);
+        else if (arg == "-elo1" && has_value)
+            elo1 = atof(argv[++i]);
+        else if (arg == "-alpha" && has_value)
+            alpha = atof(argv[++i]);
+        else if (arg == "-beta" && has_value)
+            beta = atof(argv[++i]);
+        else if (arg == "-seed" && has_value)
+            seed = unsigned(atoi(argv[++i]));
+        else if (arg == "-record" && has_value)
+            record_path = argv[++i];
+        else if (arg == "-stop")
+            stop_on_verdict = true;
+        else
+        {
+            cerr << "unknown argument " << arg << "\n";
+            return 2;
+        }
+    }
+    for (int e = 0; e < 2; ++e)
+        if (!parse_spec(spec_text[e], engines[e]))
+        {
+            cerr << "bad engine settings " << spec_text[e] << "\n";
+            return 2;
+        }
+    const int max_turns = engines[0].config("Game", "MaxNumTurns");
+    const double lower = log(beta / (1 - alpha)), upper = log((1 - beta) / alpha); //  SPRT
+
+    cout << "A: " << engines[0].text << ", level " << engines[0].level << "\n"
+         << "B: " << engines[1].text << ", level " << engines[1].level << "\n"
+         << games << " games, " << threads_num << " threads, SPRT elo0 " << elo0 << " elo1 " << elo1 << "\n";
+
+    ofstream record_file;
+    if (!record_path.empty())
+    {
+        record_file.open(record_path, ios_base::app);
+        if (!record_file)
+        {
+            cerr << "cannot write " << record_path << "\n";
+            return 1;
+        }
+    }
+
+    atomic<int> next_pair(0);
+    atomic<bool> stop(false);
+    mutex results_mutex;
+    score_table table;
+    int verdict = 0; // 1 -   elo1, -1 -  elo0
+    auto start = chrono::steady_clock::now();
+
+    auto report = [&]() {
+        const double s = table.score(), se = sqrt(table.pair_variance() / max<size_t>(table.pair_count(), 1));
+        const double llr = sprt_llr(table, elo0, elo1);
+        cout << "games " << table.games() << ": +" << table.wins << " =" << table.draws << " -" << table.losses
+             << ", score " << s << ", Elo " << elo_from_score(s) << " +- "
+             << (elo_from_score(min(s + 1.96 * se, 1.0)) - elo_from_score(max(s - 1.96 * se, 0.0))) / 2 << ", LLR "
+             << llr << " (" << lower << ", " << upper << "), pairs " << table.pairs[0] << " " << table.pairs[1] << " "
+             << table.pairs[2] << " " << table.pairs[3] << " " << table.pairs[4] << ", "
+             << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s" << endl;
+    };
+
+    //      :  ,   
+    auto worker = [&]() {
+        Logic a(&engines[0].config), b(&engines[1].config);
+        a.Max_depth = engines[0].level;
+        b.Max_depth = engines[1].level;
+        for (int pair_num = next_pair++; pair_num * 2 < games && !stop; pair_num = next_pair++)
+        {
+            mt19937 rng(seed + unsigned(pair_num));
+            Position opening;
+            while (!random_opening(a, random_plies, rng, opening))
+                ;
+            int pair_points = 0; //        
+            for (int g = 0; g < 2 && pair_num * 2 + g < games; ++g)
+            {
+                //        ,   - 
+                vector<string> record;
+                const int white_res = g == 0 ? play_game(a, b, opening, random_plies, max_turns, record)
+                                             : play_game(b, a, opening, random_plies, max_turns, record);
+                const int res = g == 0 ? white_res : -white_res;
+                lock_guard<mutex> lock(results_mutex);
+                if (record_file.is_open())
+                {
+                    const char* label = white_res > 0 ? "1" : (white_res < 0 ? "0" : "0.5");
+                    for (const auto& fen : record)
+                        record_file << fen << ' ' << label << '\n';
+                }
+                if (res > 0)
+                    ++table.wins;
+                else if (res < 0)
+                    ++table.losses;
+                else
+                    ++table.draws;
+                pair_points += res + 1;
+                if (g == 1)
+                {
+                    ++table.pairs[pair_points];
+                    const double llr = sprt_llr(table, elo0, elo1);
+                    if (!verdict && table.pair_count() >= 5 && (llr >= upper || llr <= lower))
+                    {
+                        verdict = llr >= upper ? 1 : -1;
+                        if (stop_on_verdict)
+                            stop = true;
+                    }
+                }
+                if (table.games() % 100 == 0)
+                    report();
+            }
+        }
+    };
+
+    vector<thread> workers;
+    for (int i = 0; i < threads_num; ++i)
+        workers.emplace_back(worker);
+    for (auto& w : workers)
+        w.join();
+
+    report();
+    if (verdict > 0)
+        cout << "SPRT: H1 accepted, Elo difference is at least " << elo1 << "\n";
+    else if (verdict < 0)
+        cout << "SPRT: H0 accepted, Elo difference is at most " << elo0 << "\n";
+    else
+        cout << "SPRT: no verdict yet\n";
+    return 0;
+}
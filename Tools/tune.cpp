@@ -0,0 +1,191 @@
+//    "Weighted"     ( Texel)
+// : tune <> [ ] [-threads N]
+//    -   "FEN ",   Tools/tournament.cpp  -record
+//     -    (  weights.json),   Logic  WeightsPath
+//       1 / (1 + r^-k),  r -     
+// .    k   ,   
+// ,     
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+#include "../Game/Config.h"
+#include "../Game/Logic.h"
+
+//    :  ,    
+struct labeled_position
+{
+    int8_t men[2];
+    int8_t kings[2];
+    int16_t potential[2];
+    float result; //    
+};
+
+//   :      .   
+// ,         
+bool load_samples(const string& path, Logic& logic, vector<labeled_position>& samples, size_t& skipped)
+{
+    ifstream fin(path);
+    if (!fin)
+        return false;
+    string line, fen;
+    float result;
+    skipped = 0;
+    while (getline(fin, line))
+    {
+        istringstream ss(line);
+        Position pos;
+        bool color;
+        if (!(ss >> fen >> result) || !Position::from_fen(fen, pos, color) || !pos.pieces(false) ||
+            !pos.pieces(true))
+        {
+            ++skipped;
+            continue;
+        }
+        logic.set_position(pos);
+        logic.find_turns(color);
+        if (logic.have_beats)
+        {
+            ++skipped;
+            continue;
+        }
+        labeled_position s;
+        for (int c = 0; c < 2; ++c)
+        {
+            s.men[c] = pos.men_count[c];
+            s.kings[c] = pos.king_count[c];
+            s.potential[c] = pos.potential[c];
+        }
+        s.result = result;
+        samples.push_back(s);
+        if (samples.size() % 1000000 == 0)
+            cout << "loaded " << samples.size() << " positions" << endl;
+    }
+    return true;
+}
+
+//    ,     
+double calc_error(const vector<labeled_position>& samples, const Eval_weights& w, const double scale, const int threads_num)
+{
+    vector<double> sums(threads_num, 0);
+    vector<thread> workers;
+    const size_t chunk = (samples.size() + threads_num - 1) / threads_num;
+    for (int t = 0; t < threads_num; ++t)
+        workers.emplace_back([&, t]() {
+            double sum = 0;
+            const size_t end = min(samples.size(), (t + 1) * chunk);
+            for (size_t i = t * chunk; i < end; ++i)
+            {
+                const labeled_position& s = samples[i];
+                const double white = s.men[0] + w.potential * s.potential[0] + w.king_value * s.kings[0];
+                const double black = s.men[1] + w.potential * s.potential[1] + w.king_value * s.kings[1];
+                const double predicted = 1 / (1 + pow(black / white, scale));
+                sum += (s.result - predicted) * (s.result - predicted);
+            }
+            sums[t] = sum;
+        });
+    for (auto& worker : workers)
+        worker.join();
+    double total = 0;
+    for (auto sum : sums)
+        total += sum;
+    return samples.empty() ? 0 : total / samples.size();
+}
+
+//     :   ,     min_step
+double descend(double& value, double step, const double min_step, double error,
+               const function<double()>& calc)
+{
+    while (step >= min_step)
+    {
+        bool improved = false;
+        for (const double dir : {1.0, -1.0})
+        {
+            const double old = value;
+            value += dir * step;
+            const double e = calc();
+            if (e < error)
+            {
+                error = e;
+                improved = true;
+                break;
+            }
+            value = old;
+        }
+        if (!improved)
+            step /= 2;
+    }
+    return error;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: tune <positions> [weights file] [-threads N]\n";
+        return 2;
+    }
+    const string positions_path = argv[1];
+    string weights_path = "weights.json";
+    int threads_num = max(1, int(thread::hardware_concurrency()));
+    for (int i = 2; i < argc; ++i)
+    {
+        const string arg = argv[i];
+        if (arg == "-threads" && i + 1 < argc)
+            threads_num = max(1, atoi(argv[++i]));
+        else
+            weights_path = arg;
+    }
+
+    Config config;
+    Logic logic(&config);
+    Eval_weights weights;
+    const string start_path = config("Bot", "WeightsPath");
+    if (!start_path.empty())
+        load_weights(project_path + start_path, weights); //     
+
+    auto start = chrono::steady_clock::now();
+    vector<labeled_position> samples;
+    size_t skipped = 0;
+    if (!load_samples(positions_path, logic, samples, skipped))
+    {
+        cerr << "cannot read " << positions_path << "\n";
+        return 1;
+    }
+    cout << samples.size() << " positions, " << skipped << " skipped, "
+         << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s" << endl;
+    if (samples.empty())
+        return 1;
+
+    double scale = 1;
+    auto calc = [&]() { return calc_error(samples, weights, scale, threads_num); };
+    double error = calc();
+    cout << "initial error " << error << endl;
+    error = descend(scale, 0.5, 0.01, error, calc);
+    cout << "scale " << scale << ", error " << error << endl;
+
+    //    ,        
+    for (int pass = 1;; ++pass)
+    {
+        const double before = error;
+        error = descend(weights.king_value, 0.5, 0.005, error, calc);
+        error = descend(weights.potential, 0.01, 0.0001, error, calc);
+        cout << "pass " << pass << ": KingValue " << weights.king_value << ", Potential " << weights.potential
+             << ", error " << error << ", " << chrono::duration<double>(chrono::steady_clock::now() - start).count()
+             << " s" << endl;
+        if (error >= before)
+            break;
+    }
+
+    if (!save_weights(weights_path, weights))
+    {
+        cerr << "cannot write " << weights_path << "\n";
+        return 1;
+    }
+    cout << "Written " << weights_path << endl;
+    return 0;
+}